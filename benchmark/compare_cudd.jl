@@ -0,0 +1,64 @@
+# A/B comparison of the native manager and CuddManager on the same code
+#
+#   cd benchmark/cudd_comparison && make shared    # builds libcudd.so
+#   julia --project=benchmark benchmark/compare_cudd.jl
+#
+# Every workload of workloads.jl runs unchanged on both backends, in a
+# fresh manager per sample. Besides time and memory, the node count and
+# minterm count of every root are compared, so a disagreement between the
+# backends shows up as a failed cross-check. ADD_CUDD_LIB overrides the
+# library path; ADD_BENCH_FULL=true selects the large sweeps.
+
+using AlgebraicDecisionDiagrams
+using BenchmarkTools
+using Printf
+
+include(joinpath(@__DIR__, "workloads.jl"))
+
+const SECONDS = parse(Float64, get(ENV, "COMPARE_SECONDS", "5"))
+
+"""
+    measure(build, manager)
+
+Median time of a build on `manager`, and the manager and roots of one more
+build for the statistics and the cross-check.
+"""
+function measure(build, manager)
+    trial = @benchmark $build((; manager = $manager)) evals = 1 seconds = SECONDS
+    mgr, roots = build((; manager = manager))
+    return time(median(trial)), mgr, roots
+end
+
+# Sets for ZDD workloads, minterms for the others
+signature(mgr, name, roots) =
+    startswith(name, "zdd/") ? [Float64(zdd_count(mgr, f)) for f in roots] :
+                               [Float64(count_minterms(mgr, f, mgr.num_vars)) for f in roots]
+
+function compare(io::IO)
+    @printf(io, "%-32s %12s %12s %8s %12s %12s %10s %10s %6s\n", "Workload", "Native (ms)",
+            "CUDD (ms)", "Ratio", "Memory", "CUDD", "Nodes", "CUDD", "Match")
+    println(io, "-"^122)
+    agree = true
+    for (name, build) in workloads()
+        t_native, native, native_roots = measure(build, DDManager)
+        t_cudd, cudd, cudd_roots = measure(build, CuddManager)
+        nodes = count_nodes(native, native_roots)
+        cudd_nodes = count_nodes(cudd, cudd_roots)
+        match = nodes == cudd_nodes &&
+                signature(native, name, native_roots) == signature(cudd, name, cudd_roots)
+        agree &= match
+        @printf(io, "%-32s %12.3f %12.3f %8.2f %12s %12s %10d %10d %6s\n", name, t_native / 1e6,
+                t_cudd / 1e6, t_native / t_cudd, Base.format_bytes(memory_in_use(native)),
+                Base.format_bytes(memory_in_use(cudd)), nodes, cudd_nodes, match ? "yes" : "NO")
+        close(cudd)
+    end
+    println(io, "\nRatio is native time over CUDD time (below 1: native is faster).")
+    return agree
+end
+
+if !cudd_available()
+    println(stderr, "CUDD library not found at ", cudd_library(),
+            "; run `make shared` in benchmark/cudd_comparison or set ADD_CUDD_LIB")
+    exit(2)
+end
+compare(stdout) || exit(1)
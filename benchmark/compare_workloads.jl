@@ -0,0 +1,110 @@
+# Compare the benchmark suite against CUDD on the same workloads
+#
+#   cd benchmark/cudd_comparison && make workloads          # writes cudd_workloads.csv
+#   julia --project=benchmark benchmark/compare_workloads.jl cudd_comparison/cudd_workloads.csv
+#   julia --project=benchmark benchmark/compare_workloads.jl <cudd.csv> <baseline.json>
+#
+# Without a baseline the suite is run here with the harness's sampling
+# (COMPARE_SECONDS, default 10; COMPARE_SAMPLES, default 10000); with one,
+# the times come from a file saved by run.jl. Set ADD_BENCH_FULL the same
+# for both sides, or the large sweeps are missing from one of them.
+
+using AlgebraicDecisionDiagrams
+using BenchmarkTools
+using PkgBenchmark
+using Printf
+
+include(joinpath(@__DIR__, "benchmarks.jl"))
+
+const SECONDS = parse(Float64, get(ENV, "COMPARE_SECONDS", "10"))
+const SAMPLES = parse(Int, get(ENV, "COMPARE_SAMPLES", "10000"))
+
+"""
+    read_cudd_csv(path)
+
+Rows of the CSV written by `workloads_cudd`, keyed by benchmark name.
+"""
+function read_cudd_csv(path::AbstractString)
+    lines = readlines(path)
+    header = Symbol.(split(lines[1], ","))
+    rows = Dict{String,Dict{Symbol,Float64}}()
+    for line in lines[2:end]
+        isempty(line) && continue
+        fields = split(line, ",")
+        rows[String(fields[1])] = Dict(header[k] => parse(Float64, fields[k]) for k in 2:length(header))
+    end
+    return rows
+end
+
+"""
+    julia_times(baseline)
+
+Median time in nanoseconds of every benchmark, keyed by its path joined
+with `/`, from a saved baseline or from running the suite now.
+"""
+function julia_times(baseline::Union{Nothing,AbstractString})
+    group = baseline === nothing ? run(SUITE; seconds = SECONDS, samples = SAMPLES, verbose = true) :
+            PkgBenchmark.benchmarkgroup(readresults(baseline))
+    return Dict(join(path, "/") => time(median(trial)) for (path, trial) in BenchmarkTools.leaves(group))
+end
+
+"""
+    julia_stats()
+
+Node, memory and cache statistics of one build of every workload, as
+`workloads_cudd` reports them.
+"""
+function julia_stats()
+    stats = Dict{String,NamedTuple}()
+    for (name, build) in workloads()
+        mgr, roots = build((; stats = true))
+        cache = cache_stats(mgr)
+        stats[name] = (dd_nodes = count_nodes(mgr, roots), peak_nodes = gc_stats(mgr).peak_nodes,
+                       memory_bytes = memory_in_use(mgr),
+                       cache_lookups = sum(s.lookups for s in cache; init = 0),
+                       cache_hits = sum(s.hits for s in cache; init = 0))
+    end
+    return stats
+end
+
+hit_rate(hits, lookups) = lookups == 0 ? NaN : 100 * hits / lookups
+
+function print_comparison(io::IO, cudd, times, stats)
+    @printf(io, "%-32s %12s %12s %8s %10s %10s %10s %10s %10s %10s %7s %7s\n", "Benchmark",
+            "Julia (ms)", "CUDD (ms)", "Ratio", "Nodes", "CUDD", "Peak", "CUDD", "Memory", "CUDD",
+            "Hit %", "CUDD")
+    println(io, "-"^148)
+    for name in sort!(collect(keys(cudd)))
+        c = cudd[name]
+        t = get(times, name, NaN)
+        @printf(io, "%-32s %12.3f %12.3f %8.2f", name, t / 1e6, c[:median_ns] / 1e6, t / c[:median_ns])
+        if haskey(stats, name)
+            s = stats[name]
+            @printf(io, " %10d %10d %10d %10d %10s %10s %7.1f %7.1f", s.dd_nodes, c[:dd_nodes],
+                    s.peak_nodes, c[:peak_nodes], Base.format_bytes(s.memory_bytes),
+                    Base.format_bytes(Int(c[:memory_bytes])), hit_rate(s.cache_hits, s.cache_lookups),
+                    hit_rate(c[:cache_hits], c[:cache_lookups]))
+        end
+        println(io)
+    end
+    missing_names = setdiff(keys(times), keys(cudd))
+    isempty(missing_names) || println(io, "\nNo CUDD counterpart: ", join(sort!(collect(missing_names)), ", "))
+    println(io, "\nRatio is Julia time over CUDD time (below 1: Julia is faster).")
+end
+
+function main(args)
+    if !(1 <= length(args) <= 2)
+        println(stderr, "usage: compare_workloads.jl <cudd.csv> [baseline.json]")
+        exit(2)
+    end
+    cudd = read_cudd_csv(args[1])
+    times = julia_times(get(args, 2, nothing))
+    stats = julia_stats()
+    for (name, s) in stats
+        haskey(cudd, name) && s.dd_nodes != cudd[name][:dd_nodes] &&
+            @warn "$name: $(s.dd_nodes) nodes here but $(Int(cudd[name][:dd_nodes])) in CUDD; the workloads differ"
+    end
+    print_comparison(stdout, cudd, times, stats)
+end
+
+main(ARGS)
@@ -5,24 +5,22 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/time.h>
+#include <time.h>
 #include "cudd/cudd/cudd.h"
 
-// Timing utilities (using gettimeofday for macOS compatibility)
+// Timing utilities (monotonic clock, nanosecond resolution)
 typedef struct {
-    struct timeval start;
-    struct timeval end;
+    struct timespec start;
+    struct timespec end;
 } Timer;
 
 void timer_start(Timer *t) {
-    gettimeofday(&t->start, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t->start);
 }
 
 double timer_end(Timer *t) {
-    gettimeofday(&t->end, NULL);
-    long sec_diff = t->end.tv_sec - t->start.tv_sec;
-    long usec_diff = t->end.tv_usec - t->start.tv_usec;
-    return (sec_diff * 1e6 + usec_diff) * 1000.0; // Return nanoseconds
+    clock_gettime(CLOCK_MONOTONIC, &t->end);
+    return (t->end.tv_sec - t->start.tv_sec) * 1e9 + (t->end.tv_nsec - t->start.tv_nsec); // Return nanoseconds
 }
 
 // Benchmark: BDD AND chain
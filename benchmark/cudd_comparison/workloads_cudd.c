@@ -0,0 +1,869 @@
+/*
+ * CUDD side of the workload comparison
+ *
+ * Builds the workloads of benchmark/workloads.jl with CUDD: the same
+ * constructions, sizes, variable orders and operation sequences, under the
+ * same names, so the two result sets can be joined row by row by
+ * benchmark/compare_workloads.jl.
+ *
+ *   make workloads_cudd
+ *   ./workloads_cudd [--json] [--seconds S] [--samples N] [--output FILE]
+ *
+ * ADD_BENCH_FULL=true selects the large sweeps, as in the Julia suite.
+ *
+ * Timing follows the Julia suite: every sample of a workload runs in a
+ * fresh manager and includes Cudd_Init ("cold"); every sample of an "ops"
+ * benchmark runs a single operation on operands built untimed in a fresh
+ * manager. Samples are taken for up to --seconds (default 10) or --samples
+ * (default 10000) and reported as median and minimum, with
+ * clock_gettime(CLOCK_MONOTONIC) around each sample and Cudd_Quit outside.
+ *
+ * Node, memory and cache statistics come from one extra run of each
+ * workload: the internal nodes reachable from the roots (terminals are not
+ * counted, as in count_nodes), Cudd_ReadPeakNodeCount, Cudd_ReadMemoryInUse,
+ * Cudd_ReadCacheLookUps/Hits and the garbage collector's runs and time.
+ *
+ * Julia variable v is CUDD index v - 1 throughout.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cudd/cudd/cudd.h"
+#include "cudd/cudd/cuddInt.h"
+
+/* ------------------------------------------------------------------ */
+/* Support                                                              */
+/* ------------------------------------------------------------------ */
+
+/* A workload's manager and its referenced roots */
+typedef struct {
+    DdManager *mgr;
+    DdNode **roots;
+    int num_roots;
+    int zdd;
+} Built;
+
+typedef struct {
+    char name[64];
+    int samples;
+    double median_ns;
+    double min_ns;
+    long dd_nodes;
+    long peak_nodes;
+    size_t memory;
+    double cache_lookups;
+    double cache_hits;
+    int gc_runs;
+    double gc_ms;
+} Result;
+
+static double budget_seconds = 10.0;
+static int max_samples = 10000;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void fail(const char *what)
+{
+    fprintf(stderr, "workloads_cudd: %s\n", what);
+    exit(1);
+}
+
+/* Reference a fresh result, aborting when CUDD runs out of memory */
+static DdNode *keep(DdNode *f)
+{
+    if (f == NULL)
+        fail("CUDD operation failed");
+    Cudd_Ref(f);
+    return f;
+}
+
+/* Replace the referenced *slot by the (unreferenced) result f */
+static void assign(DdManager *mgr, DdNode **slot, DdNode *f)
+{
+    keep(f);
+    Cudd_RecursiveDeref(mgr, *slot);
+    *slot = f;
+}
+
+static void assign_zdd(DdManager *mgr, DdNode **slot, DdNode *f)
+{
+    keep(f);
+    Cudd_RecursiveDerefZdd(mgr, *slot);
+    *slot = f;
+}
+
+static Built built(DdManager *mgr, int zdd, int num_roots, DdNode **roots)
+{
+    Built b = { mgr, malloc(num_roots * sizeof(DdNode *)), num_roots, zdd };
+    if (b.roots == NULL)
+        fail("out of memory");
+    memcpy(b.roots, roots, num_roots * sizeof(DdNode *));
+    return b;
+}
+
+static void release(Built *b)
+{
+    for (int r = 0; r < b->num_roots; r++) {
+        if (b->zdd)
+            Cudd_RecursiveDerefZdd(b->mgr, b->roots[r]);
+        else
+            Cudd_RecursiveDeref(b->mgr, b->roots[r]);
+    }
+    free(b->roots);
+    Cudd_Quit(b->mgr);
+}
+
+static DdManager *new_manager(int bdd_vars, int zdd_vars)
+{
+    DdManager *mgr = Cudd_Init(bdd_vars, zdd_vars, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+    if (mgr == NULL)
+        fail("Cudd_Init failed");
+    return mgr;
+}
+
+/* ------------------------------------------------------------------ */
+/* Node counting                                                        */
+/* ------------------------------------------------------------------ */
+
+/* Open-addressing set of regular node pointers */
+typedef struct {
+    DdNode **slots;
+    size_t mask;
+    size_t count;
+} NodeSet;
+
+static int nodeset_insert(NodeSet *s, DdNode *n)
+{
+    if (2 * (s->count + 1) > s->mask + 1) {
+        NodeSet grown = { calloc(2 * (s->mask + 1), sizeof(DdNode *)), 2 * s->mask + 1, 0 };
+        if (grown.slots == NULL)
+            fail("out of memory");
+        for (size_t i = 0; i <= s->mask; i++)
+            if (s->slots[i] != NULL)
+                nodeset_insert(&grown, s->slots[i]);
+        free(s->slots);
+        *s = grown;
+    }
+    size_t i = ((uintptr_t)n >> 4) * 0x9e3779b97f4a7c15ULL & s->mask;
+    while (s->slots[i] != NULL) {
+        if (s->slots[i] == n)
+            return 0;
+        i = (i + 1) & s->mask;
+    }
+    s->slots[i] = n;
+    s->count++;
+    return 1;
+}
+
+static void count_rec(NodeSet *seen, DdNode *f)
+{
+    f = Cudd_Regular(f);
+    if (Cudd_IsConstant(f) || !nodeset_insert(seen, f))
+        return;
+    count_rec(seen, Cudd_T(f));
+    count_rec(seen, Cudd_E(f));
+}
+
+/* Internal nodes reachable from the roots, shared nodes counted once */
+static long count_nodes(const Built *b)
+{
+    NodeSet seen = { calloc(1024, sizeof(DdNode *)), 1023, 0 };
+    if (seen.slots == NULL)
+        fail("out of memory");
+    for (int r = 0; r < b->num_roots; r++)
+        count_rec(&seen, b->roots[r]);
+    free(seen.slots);
+    return (long)seen.count;
+}
+
+/* ------------------------------------------------------------------ */
+/* BDD workloads                                                        */
+/* ------------------------------------------------------------------ */
+
+/* The n-queens constraint over one variable per square, row by row */
+static Built queens(int n)
+{
+    DdManager *mgr = new_manager(n * n, 0);
+#define X(i, j) Cudd_bddIthVar(mgr, (i) * n + (j))
+    DdNode *f = keep(Cudd_ReadOne(mgr));
+    for (int i = 0; i < n; i++) {
+        DdNode *row = keep(Cudd_ReadLogicZero(mgr));
+        for (int j = 0; j < n; j++)
+            assign(mgr, &row, Cudd_bddOr(mgr, row, X(i, j)));
+        assign(mgr, &f, Cudd_bddAnd(mgr, f, row));
+        Cudd_RecursiveDeref(mgr, row);
+    }
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            for (int k = i; k < n; k++)
+                for (int l = 0; l < n; l++) {
+                    if (!(k > i || (k == i && l > j)))
+                        continue;
+                    if (k == i || l == j || abs(k - i) == abs(l - j)) {
+                        DdNode *both = keep(Cudd_bddAnd(mgr, X(i, j), X(k, l)));
+                        assign(mgr, &f, Cudd_bddAnd(mgr, f, Cudd_Not(both)));
+                        Cudd_RecursiveDeref(mgr, both);
+                    }
+                }
+#undef X
+    return built(mgr, 0, 1, &f);
+}
+
+/*
+ * Ripple-carry addition of two vectors of BDDs, least significant first.
+ * Writes bits + 1 referenced sum bits; does not consume a or b.
+ */
+static void ripple_add(DdManager *mgr, DdNode **a, DdNode **b, int bits, DdNode **sum)
+{
+    DdNode *carry = keep(Cudd_ReadLogicZero(mgr));
+    for (int i = 0; i < bits; i++) {
+        DdNode *ab = keep(Cudd_bddXor(mgr, a[i], b[i]));
+        sum[i] = keep(Cudd_bddXor(mgr, ab, carry));
+        DdNode *gen = keep(Cudd_bddAnd(mgr, a[i], b[i]));
+        /* Recomputed as in the Julia workload; the second call is a cache hit */
+        DdNode *ab2 = keep(Cudd_bddXor(mgr, a[i], b[i]));
+        DdNode *prop = keep(Cudd_bddAnd(mgr, carry, ab2));
+        assign(mgr, &carry, Cudd_bddOr(mgr, gen, prop));
+        Cudd_RecursiveDeref(mgr, ab);
+        Cudd_RecursiveDeref(mgr, ab2);
+        Cudd_RecursiveDeref(mgr, gen);
+        Cudd_RecursiveDeref(mgr, prop);
+    }
+    sum[bits] = carry;
+}
+
+/* All outputs of a ripple-carry adder, operand bits interleaved or not */
+static Built adder(int bits, int interleaved)
+{
+    DdManager *mgr = new_manager(2 * bits, 0);
+    DdNode **a = malloc(bits * sizeof(DdNode *));
+    DdNode **b = malloc(bits * sizeof(DdNode *));
+    DdNode **sum = malloc((bits + 1) * sizeof(DdNode *));
+    if (a == NULL || b == NULL || sum == NULL)
+        fail("out of memory");
+    for (int i = 0; i < bits; i++) {
+        a[i] = Cudd_bddIthVar(mgr, interleaved ? 2 * i : i);
+        b[i] = Cudd_bddIthVar(mgr, interleaved ? 2 * i + 1 : bits + i);
+    }
+    ripple_add(mgr, a, b, bits, sum);
+    free(a);
+    free(b);
+    Built result = built(mgr, 0, bits + 1, sum);
+    free(sum);
+    return result;
+}
+
+/* All outputs of a shift-and-add multiplier */
+static Built multiplier(int bits)
+{
+    DdManager *mgr = new_manager(2 * bits, 0);
+    DdNode **a = malloc(bits * sizeof(DdNode *));
+    DdNode **b = malloc(bits * sizeof(DdNode *));
+    DdNode **partial = malloc(bits * sizeof(DdNode *));
+    DdNode **sum = malloc((bits + 1) * sizeof(DdNode *));
+    DdNode **product = malloc(2 * bits * sizeof(DdNode *));
+    if (a == NULL || b == NULL || partial == NULL || sum == NULL || product == NULL)
+        fail("out of memory");
+    for (int i = 0; i < bits; i++) {
+        a[i] = Cudd_bddIthVar(mgr, 2 * i);
+        b[i] = Cudd_bddIthVar(mgr, 2 * i + 1);
+    }
+    for (int i = 0; i < 2 * bits; i++)
+        product[i] = keep(Cudd_ReadLogicZero(mgr));
+    for (int j = 0; j < bits; j++) {
+        for (int i = 0; i < bits; i++)
+            partial[i] = keep(Cudd_bddAnd(mgr, a[i], b[j]));
+        ripple_add(mgr, product + j, partial, bits, sum);
+        for (int i = 0; i < bits; i++) {
+            Cudd_RecursiveDeref(mgr, partial[i]);
+            Cudd_RecursiveDeref(mgr, product[j + i]);
+        }
+        /* product[j + bits] is still zero at this point */
+        Cudd_RecursiveDeref(mgr, product[j + bits]);
+        memcpy(product + j, sum, (bits + 1) * sizeof(DdNode *));
+    }
+    free(a);
+    free(b);
+    free(partial);
+    free(sum);
+    Built result = built(mgr, 0, 2 * bits, product);
+    free(product);
+    return result;
+}
+
+/*
+ * Reachable states of a ring of n rule-30 cells from a single seed, by
+ * breadth-first image computation. Current-state variables are the even
+ * CUDD indices (odd Julia variables), next-state variables the odd ones.
+ */
+static Built image(int n, int steps)
+{
+    DdManager *mgr = new_manager(2 * n, 0);
+#define X(i) Cudd_bddIthVar(mgr, 2 * ((((i) % n) + n) % n))
+#define Y(i) Cudd_bddIthVar(mgr, 2 * ((((i) % n) + n) % n) + 1)
+    DdNode *T = keep(Cudd_ReadOne(mgr));
+    for (int i = 0; i < n; i++) {
+        DdNode *self = keep(Cudd_bddOr(mgr, X(i), X(i + 1)));
+        DdNode *next = keep(Cudd_bddXor(mgr, X(i - 1), self));
+        DdNode *same = keep(Cudd_bddXor(mgr, Y(i), next));
+        assign(mgr, &T, Cudd_bddAnd(mgr, T, Cudd_Not(same)));
+        Cudd_RecursiveDeref(mgr, self);
+        Cudd_RecursiveDeref(mgr, next);
+        Cudd_RecursiveDeref(mgr, same);
+    }
+    int *indices = malloc(n * sizeof(int));
+    int *to_current = malloc(2 * n * sizeof(int));
+    if (indices == NULL || to_current == NULL)
+        fail("out of memory");
+    for (int i = 0; i < n; i++)
+        indices[i] = 2 * i;
+    DdNode *current = keep(Cudd_IndicesToCube(mgr, indices, n));
+    for (int v = 0; v < 2 * n; v++)
+        to_current[v] = v % 2 == 0 ? v + 1 : v - 1;
+
+    DdNode *reached = keep(X(0));
+    for (int i = 1; i < n; i++)
+        assign(mgr, &reached, Cudd_bddAnd(mgr, reached, Cudd_Not(X(i))));
+    DdNode *frontier = keep(reached);
+    for (int s = 0; s < steps; s++) {
+        if (frontier == Cudd_ReadLogicZero(mgr))
+            break;
+        DdNode *img = keep(Cudd_bddAndAbstract(mgr, T, frontier, current));
+        DdNode *next = keep(Cudd_bddPermute(mgr, img, to_current));
+        assign(mgr, &frontier, Cudd_bddAnd(mgr, next, Cudd_Not(reached)));
+        assign(mgr, &reached, Cudd_bddOr(mgr, reached, frontier));
+        Cudd_RecursiveDeref(mgr, img);
+        Cudd_RecursiveDeref(mgr, next);
+    }
+#undef X
+#undef Y
+    Cudd_RecursiveDeref(mgr, frontier);
+    Cudd_RecursiveDeref(mgr, current);
+    free(indices);
+    free(to_current);
+    DdNode *roots[] = { T, reached };
+    return built(mgr, 0, 2, roots);
+}
+
+/* ------------------------------------------------------------------ */
+/* ZDD workloads                                                        */
+/* ------------------------------------------------------------------ */
+
+/* All k-element subsets of 1:n, built with change and union */
+static Built k_subsets(int n, int k)
+{
+    DdManager *mgr = new_manager(0, n);
+    /*
+     * family[j] holds the j-subsets of the variables seen so far. The base
+     * {∅} is the one terminal; Cudd_ReadZddOne would be all subsets.
+     */
+    DdNode **family = malloc((k + 1) * sizeof(DdNode *));
+    if (family == NULL)
+        fail("out of memory");
+    family[0] = keep(Cudd_ReadOne(mgr));
+    for (int j = 1; j <= k; j++)
+        family[j] = keep(Cudd_ReadZero(mgr));
+    for (int v = n; v >= 1; v--) {
+        int top = k < n - v + 1 ? k : n - v + 1;
+        for (int j = top; j >= 1; j--) {
+            DdNode *with = keep(Cudd_zddChange(mgr, family[j - 1], v - 1));
+            assign_zdd(mgr, &family[j], Cudd_zddUnion(mgr, family[j], with));
+            Cudd_RecursiveDerefZdd(mgr, with);
+        }
+    }
+    for (int j = 0; j < k; j++)
+        Cudd_RecursiveDerefZdd(mgr, family[j]);
+    Built b = built(mgr, 1, 1, &family[k]);
+    free(family);
+    return b;
+}
+
+/*
+ * The family of the given sets. CUDD has no counterpart of zdd_from_sets,
+ * so every set is built with Cudd_zddChange from the base, bottom variable
+ * first, and united into the family; the result is the same ZDD.
+ */
+static DdNode *family_of(DdManager *mgr, int **sets, const int *sizes, int count)
+{
+    DdNode *f = keep(Cudd_ReadZero(mgr));
+    for (int s = 0; s < count; s++) {
+        DdNode *set = keep(Cudd_ReadOne(mgr));
+        for (int e = sizes[s] - 1; e >= 0; e--)
+            assign_zdd(mgr, &set, Cudd_zddChange(mgr, set, sets[s][e]));
+        assign_zdd(mgr, &f, Cudd_zddUnion(mgr, f, set));
+        Cudd_RecursiveDerefZdd(mgr, set);
+    }
+    return f;
+}
+
+static int cmp_int(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/* Pseudo-random sets from the generator of the Julia workload */
+static Built random_sets(int n, int count)
+{
+    DdManager *mgr = new_manager(0, n);
+    int **sets = malloc(count * sizeof(int *));
+    int **shifted = malloc(count * sizeof(int *));
+    int *sizes = malloc(count * sizeof(int));
+    if (sets == NULL || shifted == NULL || sizes == NULL)
+        fail("out of memory");
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    for (int s = 0; s < count; s++) {
+        sets[s] = malloc(n * sizeof(int));
+        shifted[s] = malloc(n * sizeof(int));
+        if (sets[s] == NULL || shifted[s] == NULL)
+            fail("out of memory");
+        sizes[s] = 0;
+        for (int v = 0; v < n; v++) {
+            seed = seed * 0x5851f42d4c957f2dULL + 0x14057b7ef767814fULL;
+            if (seed >> 61 == 0)
+                sets[s][sizes[s]++] = v;
+        }
+        for (int e = 0; e < sizes[s]; e++)
+            shifted[s][e] = (sets[s][e] + 1) % n;
+        qsort(shifted[s], sizes[s], sizeof(int), cmp_int);
+    }
+    DdNode *f = family_of(mgr, sets, sizes, count);
+    DdNode *g = family_of(mgr, shifted, sizes, count);
+    DdNode *both = keep(Cudd_zddIntersect(mgr, f, g));
+    DdNode *only = keep(Cudd_zddDiff(mgr, f, g));
+    Cudd_RecursiveDerefZdd(mgr, g);
+    for (int s = 0; s < count; s++) {
+        free(sets[s]);
+        free(shifted[s]);
+    }
+    free(sets);
+    free(shifted);
+    free(sizes);
+    DdNode *roots[] = { f, both, only };
+    return built(mgr, 1, 3, roots);
+}
+
+/* ------------------------------------------------------------------ */
+/* ADD workload                                                         */
+/* ------------------------------------------------------------------ */
+
+/* sum_k k * var[k] over the given CUDD indices, weights from 1 */
+static DdNode *weighted(DdManager *mgr, const int *vars, int n)
+{
+    DdNode *acc = keep(Cudd_ReadZero(mgr));
+    for (int k = 0; k < n; k++) {
+        DdNode *var = keep(Cudd_addIthVar(mgr, vars[k]));
+        DdNode *w = keep(Cudd_addConst(mgr, (CUDD_VALUE_TYPE)(k + 1)));
+        DdNode *term = keep(Cudd_addApply(mgr, Cudd_addTimes, var, w));
+        assign(mgr, &acc, Cudd_addApply(mgr, Cudd_addPlus, acc, term));
+        Cudd_RecursiveDeref(mgr, var);
+        Cudd_RecursiveDeref(mgr, w);
+        Cudd_RecursiveDeref(mgr, term);
+    }
+    return acc;
+}
+
+/*
+ * Multiply two 2^bits-square matrices and sum the product's entries.
+ * Rows, summation and columns use interleaved variables x, z and y.
+ */
+static Built add_matrices(int bits)
+{
+    DdManager *mgr = new_manager(3 * bits, 0);
+    int *x = malloc(bits * sizeof(int));
+    int *z = malloc(bits * sizeof(int));
+    int *z_reversed = malloc(bits * sizeof(int));
+    int *y = malloc(bits * sizeof(int));
+    int *xy = malloc(2 * bits * sizeof(int));
+    DdNode **z_vars = malloc(bits * sizeof(DdNode *));
+    DdNode **xy_vars = malloc(2 * bits * sizeof(DdNode *));
+    if (!x || !z || !z_reversed || !y || !xy || !z_vars || !xy_vars)
+        fail("out of memory");
+    for (int i = 0; i < bits; i++) {
+        x[i] = 3 * i;
+        z[i] = 3 * i + 1;
+        y[i] = 3 * i + 2;
+        z_reversed[bits - 1 - i] = z[i];
+        xy[i] = x[i];
+        xy[bits + i] = y[i];
+    }
+    for (int i = 0; i < bits; i++)
+        z_vars[i] = keep(Cudd_addIthVar(mgr, z[i]));
+    for (int i = 0; i < 2 * bits; i++)
+        xy_vars[i] = keep(Cudd_addIthVar(mgr, xy[i]));
+
+    DdNode *wx = weighted(mgr, x, bits);
+    DdNode *wzr = weighted(mgr, z_reversed, bits);
+    DdNode *half = keep(Cudd_addConst(mgr, 0.5));
+    DdNode *scaled = keep(Cudd_addApply(mgr, Cudd_addTimes, wzr, half));
+    DdNode *A = keep(Cudd_addApply(mgr, Cudd_addMaximum, wx, scaled));
+
+    DdNode *wz = weighted(mgr, z, bits);
+    DdNode *one = Cudd_ReadOne(mgr);
+    DdNode *wz1 = keep(Cudd_addApply(mgr, Cudd_addPlus, wz, one));
+    DdNode *wy = weighted(mgr, y, bits);
+    DdNode *B = keep(Cudd_addApply(mgr, Cudd_addTimes, wz1, wy));
+
+    DdNode *C = keep(Cudd_addMatrixMultiply(mgr, A, B, z_vars, bits));
+    DdNode *cube = keep(Cudd_addComputeCube(mgr, xy_vars, NULL, 2 * bits));
+    DdNode *total = keep(Cudd_addExistAbstract(mgr, C, cube));
+
+    DdNode *temps[] = { wx, wzr, half, scaled, A, wz, wz1, wy, B, cube };
+    for (size_t i = 0; i < sizeof(temps) / sizeof(temps[0]); i++)
+        Cudd_RecursiveDeref(mgr, temps[i]);
+    for (int i = 0; i < bits; i++)
+        Cudd_RecursiveDeref(mgr, z_vars[i]);
+    for (int i = 0; i < 2 * bits; i++)
+        Cudd_RecursiveDeref(mgr, xy_vars[i]);
+    free(x);
+    free(z);
+    free(z_reversed);
+    free(y);
+    free(xy);
+    free(z_vars);
+    free(xy_vars);
+    DdNode *roots[] = { C, total };
+    return built(mgr, 0, 2, roots);
+}
+
+/* ------------------------------------------------------------------ */
+/* Workload table                                                       */
+/* ------------------------------------------------------------------ */
+
+typedef enum { QUEENS, ADDER, ADDER_SEPARATED, MULTIPLIER, IMAGE, K_SUBSETS, RANDOM_SETS,
+               MATRIX_MULTIPLY } Kind;
+
+typedef struct {
+    Kind kind;
+    int p, q;
+} Workload;
+
+static Built build(Workload w)
+{
+    switch (w.kind) {
+    case QUEENS: return queens(w.p);
+    case ADDER: return adder(w.p, 1);
+    case ADDER_SEPARATED: return adder(w.p, 0);
+    case MULTIPLIER: return multiplier(w.p);
+    case IMAGE: return image(w.p, 2 * w.p);
+    case K_SUBSETS: return k_subsets(w.p, w.q);
+    case RANDOM_SETS: return random_sets(w.p, w.q);
+    case MATRIX_MULTIPLY: return add_matrices(w.p);
+    }
+    fail("unknown workload");
+    return queens(0);
+}
+
+/* The instances of workloads() in benchmark/workloads.jl, in its order */
+static int workload_list(int full, Workload *list, char (*names)[64])
+{
+    static const struct { Kind kind; const char *name; int quick[3][2]; int full[3][2]; } table[] = {
+        { QUEENS, "bdd/queens/%d", { { 6 }, { 8 } }, { { 6 }, { 8 }, { 10 } } },
+        { ADDER, "bdd/adder/%d", { { 64 }, { 256 } }, { { 64 }, { 256 }, { 1024 } } },
+        { ADDER_SEPARATED, "bdd/adder_separated/%d", { { 8 }, { 10 }, { 12 } },
+          { { 10 }, { 14 }, { 18 } } },
+        { MULTIPLIER, "bdd/multiplier/%d", { { 6 }, { 8 } }, { { 8 }, { 10 }, { 12 } } },
+        { IMAGE, "bdd/image/%d", { { 8 }, { 12 } }, { { 12 }, { 16 }, { 20 } } },
+        { K_SUBSETS, "zdd/k_subsets/%d/%d", { { 100, 10 }, { 200, 50 } },
+          { { 200, 50 }, { 1000, 250 }, { 2000, 500 } } },
+        { RANDOM_SETS, "zdd/random_sets/%d/%d", { { 32, 1000 }, { 64, 10000 } },
+          { { 64, 10000 }, { 128, 100000 } } },
+        { MATRIX_MULTIPLY, "add/matrix_multiply/%d", { { 3 }, { 4 } }, { { 4 }, { 6 }, { 8 } } },
+    };
+    int count = 0;
+    for (size_t t = 0; t < sizeof(table) / sizeof(table[0]); t++) {
+        for (int s = 0; s < 3; s++) {
+            const int *size = full ? table[t].full[s] : table[t].quick[s];
+            if (size[0] == 0)
+                continue;
+            Workload w = { table[t].kind, size[0], size[1] };
+            list[count] = w;
+            snprintf(names[count], 64, table[t].name, size[0], size[1]);
+            count++;
+        }
+    }
+    return count;
+}
+
+/* ------------------------------------------------------------------ */
+/* Single operations on prebuilt operands                               */
+/* ------------------------------------------------------------------ */
+
+/*
+ * The "ops" group of benchmark/benchmarks.jl, except save_dd and
+ * add_eval_batch, which have no counterpart in the CUDD library itself.
+ */
+typedef enum { OP_AND_EXISTS, OP_PERMUTE, OP_RESTRICT, OP_COUNT_MINTERMS, OP_GARBAGE_COLLECT,
+               OP_REORDER, NUM_OPS } Op;
+
+static const char *op_names[NUM_OPS] = {
+    "ops/and_exists", "ops/permute", "ops/restrict", "ops/count_minterms",
+    "ops/garbage_collect", "ops/reorder",
+};
+
+typedef struct {
+    Built b;
+    DdNode *operand;    /* Referenced cube, or NULL */
+    int permut[256];
+} OpSetup;
+
+static OpSetup op_setup(Op op)
+{
+    OpSetup s;
+    s.operand = NULL;
+    switch (op) {
+    case OP_AND_EXISTS: {
+        s.b = image(12, 24);
+        int indices[12];
+        for (int i = 0; i < 12; i++)
+            indices[i] = 2 * i;
+        s.operand = keep(Cudd_IndicesToCube(s.b.mgr, indices, 12));
+        break;
+    }
+    case OP_PERMUTE:
+        s.b = adder(128, 1);
+        for (int v = 0; v < 256; v++)
+            s.permut[v] = v % 2 == 0 ? v + 1 : v - 1;
+        break;
+    case OP_RESTRICT:
+        s.b = multiplier(7);
+        break;
+    case OP_COUNT_MINTERMS:
+        s.b = queens(8);
+        break;
+    case OP_GARBAGE_COLLECT:
+        /* Nothing is referenced, so the collector frees every node */
+        s.b = multiplier(8);
+        for (int r = 0; r < s.b.num_roots; r++)
+            Cudd_RecursiveDeref(s.b.mgr, s.b.roots[r]);
+        s.b.num_roots = 0;
+        break;
+    case OP_REORDER:
+        s.b = adder(10, 0);
+        break;
+    default:
+        fail("unknown operation");
+    }
+    return s;
+}
+
+/* Run the operation once; returns a referenced result or NULL */
+static DdNode *op_run(Op op, OpSetup *s)
+{
+    DdManager *mgr = s->b.mgr;
+    DdNode **roots = s->b.roots;
+    switch (op) {
+    case OP_AND_EXISTS:
+        return keep(Cudd_bddAndAbstract(mgr, roots[0], roots[1], s->operand));
+    case OP_PERMUTE:
+        return keep(Cudd_bddPermute(mgr, roots[s->b.num_roots - 1], s->permut));
+    case OP_RESTRICT:
+        return keep(Cudd_bddRestrict(mgr, roots[6], roots[2]));
+    case OP_COUNT_MINTERMS:
+        if (Cudd_CountMinterm(mgr, roots[0], 64) == (double)CUDD_OUT_OF_MEM)
+            fail("Cudd_CountMinterm failed");
+        return NULL;
+    case OP_GARBAGE_COLLECT:
+        cuddGarbageCollect(mgr, 1);
+        return NULL;
+    case OP_REORDER:
+        if (!Cudd_ReduceHeap(mgr, CUDD_REORDER_SIFT, 0))
+            fail("Cudd_ReduceHeap failed");
+        return NULL;
+    default:
+        fail("unknown operation");
+    }
+    return NULL;
+}
+
+static void op_release(OpSetup *s, DdNode *result)
+{
+    if (result != NULL)
+        Cudd_RecursiveDeref(s->b.mgr, result);
+    if (s->operand != NULL)
+        Cudd_RecursiveDeref(s->b.mgr, s->operand);
+    release(&s->b);
+}
+
+/* ------------------------------------------------------------------ */
+/* Measurement                                                          */
+/* ------------------------------------------------------------------ */
+
+static void summarize(Result *r, double *times, int samples)
+{
+    qsort(times, samples, sizeof(double), cmp_double);
+    r->samples = samples;
+    r->min_ns = times[0];
+    r->median_ns = samples % 2 == 1 ? times[samples / 2]
+                                    : (times[samples / 2 - 1] + times[samples / 2]) / 2;
+}
+
+static void record_stats(Result *r, DdManager *mgr, long dd_nodes)
+{
+    r->dd_nodes = dd_nodes;
+    r->peak_nodes = Cudd_ReadPeakNodeCount(mgr);
+    r->memory = Cudd_ReadMemoryInUse(mgr);
+    r->cache_lookups = Cudd_ReadCacheLookUps(mgr);
+    r->cache_hits = Cudd_ReadCacheHits(mgr);
+    r->gc_runs = Cudd_ReadGarbageCollections(mgr);
+    r->gc_ms = (double)Cudd_ReadGarbageCollectionTime(mgr);
+}
+
+static Result measure_workload(const char (*name)[64], Workload w, double *times)
+{
+    Result r;
+    memset(&r, 0, sizeof(r));
+    memcpy(r.name, *name, sizeof(r.name));
+
+    Built b = build(w);
+    record_stats(&r, b.mgr, count_nodes(&b));
+    release(&b);
+
+    int samples = 0;
+    double deadline = now_ns() + budget_seconds * 1e9;
+    do {
+        double start = now_ns();
+        Built sample = build(w);
+        times[samples++] = now_ns() - start;
+        release(&sample);
+    } while (samples < max_samples && now_ns() < deadline);
+    summarize(&r, times, samples);
+    return r;
+}
+
+/* Statistics of an operation only cover the operation, not its setup */
+static Result measure_op(Op op, double *times)
+{
+    Result r;
+    memset(&r, 0, sizeof(r));
+    snprintf(r.name, sizeof(r.name), "%s", op_names[op]);
+
+    OpSetup s = op_setup(op);
+    double lookups = Cudd_ReadCacheLookUps(s.b.mgr);
+    double hits = Cudd_ReadCacheHits(s.b.mgr);
+    int gc_runs = Cudd_ReadGarbageCollections(s.b.mgr);
+    long gc_ms = Cudd_ReadGarbageCollectionTime(s.b.mgr);
+    DdNode *result = op_run(op, &s);
+    record_stats(&r, s.b.mgr, result == NULL ? 0 : Cudd_DagSize(result) - 1);
+    r.cache_lookups -= lookups;
+    r.cache_hits -= hits;
+    r.gc_runs -= gc_runs;
+    r.gc_ms -= (double)gc_ms;
+    op_release(&s, result);
+
+    int samples = 0;
+    double deadline = now_ns() + budget_seconds * 1e9;
+    do {
+        s = op_setup(op);
+        double start = now_ns();
+        result = op_run(op, &s);
+        times[samples++] = now_ns() - start;
+        op_release(&s, result);
+    } while (samples < max_samples && now_ns() < deadline);
+    summarize(&r, times, samples);
+    return r;
+}
+
+/* ------------------------------------------------------------------ */
+/* Output                                                               */
+/* ------------------------------------------------------------------ */
+
+static void write_csv(FILE *out, const Result *results, int count)
+{
+    fprintf(out, "name,samples,median_ns,min_ns,dd_nodes,peak_nodes,memory_bytes,"
+                 "cache_lookups,cache_hits,gc_runs,gc_ms\n");
+    for (int i = 0; i < count; i++) {
+        const Result *r = &results[i];
+        fprintf(out, "%s,%d,%.0f,%.0f,%ld,%ld,%zu,%.0f,%.0f,%d,%.0f\n", r->name, r->samples,
+                r->median_ns, r->min_ns, r->dd_nodes, r->peak_nodes, r->memory,
+                r->cache_lookups, r->cache_hits, r->gc_runs, r->gc_ms);
+    }
+}
+
+static void write_json(FILE *out, const Result *results, int count)
+{
+    fprintf(out, "[\n");
+    for (int i = 0; i < count; i++) {
+        const Result *r = &results[i];
+        fprintf(out,
+                "  {\"name\": \"%s\", \"samples\": %d, \"median_ns\": %.0f, \"min_ns\": %.0f, "
+                "\"dd_nodes\": %ld, \"peak_nodes\": %ld, \"memory_bytes\": %zu, "
+                "\"cache_lookups\": %.0f, \"cache_hits\": %.0f, \"gc_runs\": %d, "
+                "\"gc_ms\": %.0f}%s\n",
+                r->name, r->samples, r->median_ns, r->min_ns, r->dd_nodes, r->peak_nodes,
+                r->memory, r->cache_lookups, r->cache_hits, r->gc_runs, r->gc_ms,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: workloads_cudd [--json] [--seconds S] [--samples N] [--output FILE]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    int json = 0;
+    const char *output = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0)
+            json = 1;
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            budget_seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+            max_samples = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else
+            usage();
+    }
+    if (budget_seconds <= 0 || max_samples < 1)
+        usage();
+
+    const char *full = getenv("ADD_BENCH_FULL");
+    Workload list[32];
+    char names[32][64];
+    int num_workloads = workload_list(full != NULL && strcmp(full, "true") == 0, list, names);
+
+    Result results[32 + NUM_OPS];
+    double *times = malloc(max_samples * sizeof(double));
+    if (times == NULL)
+        fail("out of memory");
+    int count = 0;
+    for (int i = 0; i < num_workloads; i++) {
+        fprintf(stderr, "%s\n", names[i]);
+        results[count++] = measure_workload(&names[i], list[i], times);
+    }
+    for (int op = 0; op < NUM_OPS; op++) {
+        fprintf(stderr, "%s\n", op_names[op]);
+        results[count++] = measure_op((Op)op, times);
+    }
+    free(times);
+
+    FILE *out = output == NULL ? stdout : fopen(output, "w");
+    if (out == NULL)
+        fail("cannot open the output file");
+    if (json)
+        write_json(out, results, count);
+    else
+        write_csv(out, results, count);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
@@ -0,0 +1,96 @@
+# Run the benchmark suite, save baselines and judge against them
+#
+#   julia --project=benchmark benchmark/run.jl [run]         # save baselines/<commit>.json
+#   julia --project=benchmark benchmark/run.jl judge <base>  # <base>: a saved .json or a git ref
+#   julia --project=benchmark benchmark/run.jl nodes         # node and GC report of the workloads
+#
+# `judge` prints a markdown table and exits with status 1 if a benchmark
+# regressed by more than the tolerance (ADD_BENCH_TOLERANCE, default 0.05).
+
+using AlgebraicDecisionDiagrams
+using BenchmarkTools
+using PkgBenchmark
+using Printf
+
+include(joinpath(@__DIR__, "workloads.jl"))
+
+const BASELINES = joinpath(@__DIR__, "baselines")
+const TOLERANCE = parse(Float64, get(ENV, "ADD_BENCH_TOLERANCE", "0.05"))
+
+git_commit() = readchomp(`git -C $(@__DIR__) rev-parse --short HEAD`)
+
+config(id = nothing) = BenchmarkConfig(id = id, env = Dict("ADD_BENCH_FULL" => string(FULL_SWEEP),
+                                                        "JULIA_NUM_THREADS" => string(Threads.nthreads())))
+
+function run_suite(target = config())
+    return benchmarkpkg(AlgebraicDecisionDiagrams, target; retune = false)
+end
+
+"""
+    print_allocations(io, group)
+
+Median time, GC time, memory and allocations of every benchmark.
+"""
+function print_allocations(io::IO, group::BenchmarkGroup)
+    @printf(io, "%-40s %12s %10s %12s %12s\n", "Benchmark", "Time (ms)", "GC %", "Memory", "Allocs")
+    println(io, "-"^90)
+    for (path, trial) in sort!(collect(BenchmarkTools.leaves(group)); by = first)
+        est = median(trial)
+        gc = est.time == 0 ? 0.0 : 100 * est.gctime / est.time
+        @printf(io, "%-40s %12.3f %10.1f %12s %12d\n", join(path, "/"), est.time / 1e6, gc,
+                Base.format_bytes(est.memory), est.allocs)
+    end
+end
+
+"""
+    print_nodes(io)
+
+Build every workload once with statistics on and report the diagram sizes,
+the peak node count, memory use and the garbage collector.
+"""
+function print_nodes(io::IO)
+    @printf(io, "%-40s %12s %12s %12s %6s %10s\n", "Workload", "DD nodes", "Peak nodes",
+            "Memory", "GCs", "GC (ms)")
+    println(io, "-"^96)
+    for (name, build) in workloads()
+        mgr, roots = build((; stats = true))
+        gc = gc_stats(mgr)
+        @printf(io, "%-40s %12d %12d %12s %6d %10.3f\n", name, count_nodes(mgr, roots),
+                gc.peak_nodes, Base.format_bytes(memory_in_use(mgr)), gc.runs, 1000 * gc.time)
+    end
+end
+
+function save_baseline()
+    results = run_suite()
+    mkpath(BASELINES)
+    path = joinpath(BASELINES, "$(git_commit()).json")
+    writeresults(path, results)
+    print_allocations(stdout, PkgBenchmark.benchmarkgroup(results))
+    println("\nSaved ", path)
+    return results
+end
+
+function judge_against(base::AbstractString)
+    results = run_suite()
+    baseline = isfile(base) ? readresults(base) : run_suite(config(base))
+    judgement = judge(results, baseline, median; time_tolerance = TOLERANCE)
+    export_markdown(stdout, judgement)
+    regressed = BenchmarkTools.regressions(PkgBenchmark.benchmarkgroup(judgement))
+    return isempty(regressed)
+end
+
+function main(args)
+    command = isempty(args) ? "run" : args[1]
+    if command == "run"
+        save_baseline()
+    elseif command == "judge" && length(args) == 2
+        judge_against(args[2]) || exit(1)
+    elseif command == "nodes"
+        print_nodes(stdout)
+    else
+        println(stderr, "usage: run.jl [run | judge <baseline.json | git ref> | nodes]")
+        exit(2)
+    end
+end
+
+main(ARGS)
@@ -0,0 +1,208 @@
+# Workloads shared by the benchmark suite and the report in run.jl
+#
+# Every workload builds its diagrams in a fresh manager, created with the
+# keyword arguments it is given, and returns the manager and the roots.
+# `manager` picks the backend: DDManager, or CuddManager to run the same
+# code on CUDD.
+
+using AlgebraicDecisionDiagrams
+
+# Set ADD_BENCH_FULL=true for the sweeps up to millions of nodes
+const FULL_SWEEP = get(ENV, "ADD_BENCH_FULL", "false") == "true"
+
+"""
+    queens(n; kwargs...)
+
+The n-queens constraint as a BDD over one variable per square, row by row.
+"""
+function queens(n::Int; manager = DDManager, kwargs...)
+    mgr = manager(n * n; kwargs...)
+    x(i, j) = ith_var(mgr, (i - 1) * n + j)
+    f = mgr.one
+    for i in 1:n
+        row = mgr.zero
+        for j in 1:n
+            row = bdd_or(mgr, row, x(i, j))
+        end
+        f = bdd_and(mgr, f, row)
+    end
+    for i in 1:n, j in 1:n, k in i:n, l in 1:n
+        (k, l) > (i, j) || continue
+        if k == i || l == j || abs(k - i) == abs(l - j)
+            f = bdd_and(mgr, f, bdd_not(mgr, bdd_and(mgr, x(i, j), x(k, l))))
+        end
+    end
+    return mgr, [f]
+end
+
+# Ripple-carry addition of two bit vectors of BDDs, least significant first
+function ripple_add(mgr, a::Vector{NodeId}, b::Vector{NodeId})
+    carry = mgr.zero
+    sum = NodeId[]
+    for (ai, bi) in zip(a, b)
+        push!(sum, bdd_xor(mgr, bdd_xor(mgr, ai, bi), carry))
+        carry = bdd_or(mgr, bdd_and(mgr, ai, bi), bdd_and(mgr, carry, bdd_xor(mgr, ai, bi)))
+    end
+    push!(sum, carry)
+    return sum
+end
+
+"""
+    adder(bits; interleaved = true, kwargs...)
+
+All outputs of a `bits`-bit ripple-carry adder. Interleaving the operand bits
+keeps the BDDs linear; putting all of `a` above all of `b` makes the carry
+exponential, which the large sweeps use to reach millions of nodes.
+"""
+function adder(bits::Int; interleaved::Bool = true, manager = DDManager, kwargs...)
+    mgr = manager(2 * bits; kwargs...)
+    a = [ith_var(mgr, interleaved ? 2i - 1 : i) for i in 1:bits]
+    b = [ith_var(mgr, interleaved ? 2i : bits + i) for i in 1:bits]
+    return mgr, ripple_add(mgr, a, b)
+end
+
+"""
+    multiplier(bits; kwargs...)
+
+All outputs of a `bits`×`bits` shift-and-add multiplier; the middle bits
+grow exponentially under any order.
+"""
+function multiplier(bits::Int; manager = DDManager, kwargs...)
+    mgr = manager(2 * bits; kwargs...)
+    a = [ith_var(mgr, 2i - 1) for i in 1:bits]
+    b = [ith_var(mgr, 2i) for i in 1:bits]
+    product = fill(mgr.zero, 2 * bits)
+    for j in 1:bits
+        partial = [bdd_and(mgr, a[i], b[j]) for i in 1:bits]
+        sum = ripple_add(mgr, product[j:(j + bits - 1)], partial)
+        product[j:(j + bits)] = sum
+    end
+    return mgr, product
+end
+
+"""
+    image(n; kwargs...)
+
+Reachable states of a ring of `n` cells that each step become
+`left ⊻ (self ∨ right)` (rule 30), from a single seed, by breadth-first
+image computation with `bdd_and_exists` and `bdd_permute`. Current-state
+variables are odd, next-state variables even.
+"""
+function image(n::Int; steps::Int = 2n, manager = DDManager, kwargs...)
+    mgr = manager(2n; kwargs...)
+    x(i) = ith_var(mgr, 2 * mod1(i, n) - 1)
+    y(i) = ith_var(mgr, 2 * mod1(i, n))
+    T = mgr.one
+    for i in 1:n
+        next = bdd_xor(mgr, x(i - 1), bdd_or(mgr, x(i), x(i + 1)))
+        T = bdd_and(mgr, T, bdd_not(mgr, bdd_xor(mgr, y(i), next)))
+    end
+    current = bdd_cube(mgr, [2i - 1 for i in 1:n])
+    to_current = [isodd(v) ? v + 1 : v - 1 for v in 1:2n]
+
+    reached = x(1)
+    for i in 2:n
+        reached = bdd_and(mgr, reached, bdd_not(mgr, x(i)))
+    end
+    frontier = reached
+    for _ in 1:steps
+        frontier == mgr.zero && break
+        next = bdd_permute(mgr, bdd_and_exists(mgr, T, frontier, current), to_current)
+        frontier = bdd_and(mgr, next, bdd_not(mgr, reached))
+        reached = bdd_or(mgr, reached, frontier)
+    end
+    return mgr, [T, reached]
+end
+
+"""
+    k_subsets(n, k; kwargs...)
+
+The family of all `k`-element subsets of `1:n` as a ZDD, built with
+`zdd_change` and `zdd_union`; it has `k * (n - k + 1)` nodes.
+"""
+function k_subsets(n::Int, k::Int; manager = DDManager, kwargs...)
+    mgr = manager(n; kwargs...)
+    # family[j + 1] holds the j-subsets of the variables seen so far
+    family = [zdd_base(mgr); fill(zdd_empty(mgr), k)]
+    for v in n:-1:1
+        for j in min(k, n - v + 1):-1:1
+            family[j + 1] = zdd_union(mgr, family[j + 1], zdd_change(mgr, family[j], v))
+        end
+    end
+    return mgr, [family[k + 1]]
+end
+
+"""
+    random_sets(n, count; kwargs...)
+
+A ZDD of `count` pseudo-random subsets of `1:n` from `zdd_from_sets`,
+intersected with and subtracted from a shifted copy.
+"""
+function random_sets(n::Int, count::Int; manager = DDManager, kwargs...)
+    mgr = manager(n; kwargs...)
+    seed = UInt64(0x9e3779b97f4a7c15)
+    sets = Vector{Vector{Int}}(undef, count)
+    for s in 1:count
+        set = Int[]
+        for v in 1:n
+            seed = seed * 0x5851f42d4c957f2d + 0x14057b7ef767814f
+            seed >> 61 == 0 && push!(set, v)
+        end
+        sets[s] = set
+    end
+    f = zdd_from_sets(mgr, sets)
+    g = zdd_from_sets(mgr, [[mod1(v + 1, n) for v in set] for set in sets])
+    return mgr, [f, zdd_intersection(mgr, f, g), zdd_difference(mgr, f, g)]
+end
+
+"""
+    add_matrices(bits; kwargs...)
+
+Multiply two `2^bits`-square ADD matrices with `add_matrix_multiply` and
+sum the product's entries with `add_exist_abstract`. Rows, summation and
+columns use interleaved variables `x`, `z` and `y`.
+"""
+function add_matrices(bits::Int; manager = DDManager, kwargs...)
+    mgr = manager(3 * bits; kwargs...)
+    weighted(vars) = foldl((acc, (i, v)) -> add_plus(mgr, acc,
+                               add_scalar_multiply(mgr, add_ith_var(mgr, v), i)),
+                           enumerate(vars); init = mgr.add_zero)
+    x = [3i - 2 for i in 1:bits]
+    z = [3i - 1 for i in 1:bits]
+    y = [3i for i in 1:bits]
+    A = add_max(mgr, weighted(x), add_scalar_multiply(mgr, weighted(reverse(z)), 0.5))
+    B = add_times(mgr, add_plus(mgr, weighted(z), mgr.one), weighted(y))
+    C = add_matrix_multiply(mgr, A, B, z)
+    return mgr, [C, add_exist_abstract(mgr, C, vcat(x, y))]
+end
+
+# Instances of each workload: (name, thunk taking manager keyword arguments)
+function workloads()
+    list = Tuple{String,Function}[]
+    add!(name, f) = push!(list, (name, f))
+    for n in (FULL_SWEEP ? (6, 8, 10) : (6, 8))
+        add!("bdd/queens/$n", kw -> queens(n; kw...))
+    end
+    for bits in (FULL_SWEEP ? (64, 256, 1024) : (64, 256))
+        add!("bdd/adder/$bits", kw -> adder(bits; kw...))
+    end
+    for bits in (FULL_SWEEP ? (10, 14, 18) : (8, 10, 12))
+        add!("bdd/adder_separated/$bits", kw -> adder(bits; interleaved = false, kw...))
+    end
+    for bits in (FULL_SWEEP ? (8, 10, 12) : (6, 8))
+        add!("bdd/multiplier/$bits", kw -> multiplier(bits; kw...))
+    end
+    for n in (FULL_SWEEP ? (12, 16, 20) : (8, 12))
+        add!("bdd/image/$n", kw -> image(n; kw...))
+    end
+    for (n, k) in (FULL_SWEEP ? ((200, 50), (1000, 250), (2000, 500)) : ((100, 10), (200, 50)))
+        add!("zdd/k_subsets/$n/$k", kw -> k_subsets(n, k; kw...))
+    end
+    for (n, count) in (FULL_SWEEP ? ((64, 10_000), (128, 100_000)) : ((32, 1000), (64, 10_000)))
+        add!("zdd/random_sets/$n/$count", kw -> random_sets(n, count; kw...))
+    end
+    for bits in (FULL_SWEEP ? (4, 6, 8) : (3, 4))
+        add!("add/matrix_multiply/$bits", kw -> add_matrices(bits; kw...))
+    end
+    return list
+end
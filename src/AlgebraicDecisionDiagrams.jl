@@ -1,37 +1,71 @@
 module AlgebraicDecisionDiagrams
 
+using Mmap
+using Preferences
+
 # Export types
-export DDManager, NodeId
+export DDManager, NodeId, CompiledADD
 
 # Export BDD operations
 export ith_var, bdd_and, bdd_or, bdd_xor, bdd_not, bdd_ite
-export bdd_restrict, bdd_exists, bdd_forall
+export bdd_restrict, bdd_exists, bdd_forall, bdd_cube, bdd_and_exists
+export bdd_cubes, bdd_minterms, bdd_from_cubes, bdd_from_truth_table
+export bdd_vector_compose, bdd_permute
+export bdd_constrain, bdd_li_compaction, bdd_squeeze
 
 # Export ADD operations
 export add_const, add_ith_var
 export add_plus, add_minus, add_times, add_divide
 export add_max, add_min, add_negate, add_scalar_multiply
 export add_threshold, add_restrict, add_eval
-export add_find_max, add_find_min
+export compile_add, add_eval_batch, add_eval_batch!
+export add_apply, register_add_op!
+export add_find_max, add_find_min, set_epsilon!
+export add_exist_abstract, add_univ_abstract, add_max_abstract, add_min_abstract
+export add_matrix_multiply, add_permute
 
 # Export ZDD operations
 export zdd_empty, zdd_base, zdd_singleton
 export zdd_union, zdd_intersection, zdd_difference
 export zdd_subset0, zdd_subset1, zdd_change
-export zdd_count, zdd_from_sets, zdd_to_sets
+export zdd_count, zdd_log_count, zdd_from_sets, zdd_to_sets, zdd_sets
 
 # Export utility functions
-export count_nodes, count_paths, count_minterms
+export count_nodes, count_paths, count_minterms, log_count_minterms
 export print_dd, to_dot
+export save_dd, load_dd, load_dds
 export garbage_collect!, check_gc
+export DDHandle, release!, safe_point!
+export set_node_limit!, set_memory_limit!, NodeLimitExceeded
+export cache_stats, reset_cache_stats!, set_max_cache_size!
+export enable_stats!, disable_stats!, reset_stats!, unique_stats, gc_stats
+export memory_in_use, print_stats
+
+# Export variable reordering
+export reduce_heap!, enable_reordering!, disable_reordering!, check_reorder
+
+# Export parallel operations
+export parallel_and, parallel_or, parallel_xor, parallel_ite, parallel_add_apply
+export parallel_reduce, transfer
+
+# Export the CUDD backend
+export CuddManager, cudd_available, cudd_library
 
 # Include source files
 include("types.jl")
 include("unique.jl")
 include("cache.jl")
+include("apply.jl")
 include("bdd.jl")
 include("add.jl")
 include("zdd.jl")
 include("utils.jl")
+include("stats.jl")
+include("reorder.jl")
+include("parallel.jl")
+include("serialize.jl")
+include("iterators.jl")
+include("handles.jl")
+include("cudd.jl")
 
 end # module AlgebraicDecisionDiagrams
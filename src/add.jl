@@ -1,26 +1,30 @@
 # ADD (Algebraic Decision Diagram) operations
 
 """
-    add_const(mgr::DDManager, value::Float64)
+    add_const(mgr::DDManager{T}, value::Real)
 
-Create an ADD representing a constant value.
+Create an ADD representing a constant value, converted to the manager's
+value type `T`.
+Constants are hash-consed in the manager's constant table, so equal values
+(or values within `mgr.epsilon`, see [`set_epsilon!`](@ref)) share a terminal.
 """
-function add_const(mgr::DDManager, value::Float64)
-    # Check if this constant already exists
-    for i in 1:length(mgr.nodes)
-        node = mgr.nodes[i]
-        if is_terminal(node) && node.value == value
-            return NodeId(i << 1)
-        end
-    end
+function add_const(mgr::DDManager, value::Real)
+    return const_lookup(mgr, value)
+end
 
-    # Create new terminal node
-    node = DDNode(value)
-    push!(mgr.nodes, node)
-    node_idx = length(mgr.nodes)
-    mgr.num_nodes += 1
+"""
+    set_epsilon!(mgr::DDManager, epsilon::Float64)
 
-    return NodeId(node_idx << 1)
+Set the tolerance used to merge ADD constants, like CUDD's `Cudd_SetEpsilon`.
+With `epsilon == 0` (the default) constants are matched by exact value;
+otherwise `add_const` returns an existing terminal within `epsilon` of the
+requested value. Terminals created earlier are kept as they are.
+"""
+function set_epsilon!(mgr::DDManager, epsilon::Float64)
+    epsilon >= 0.0 || throw(ArgumentError("epsilon must be non-negative"))
+    mgr.epsilon = epsilon
+    rehash_const_table!(mgr, length(mgr.const_table.slots))
+    return mgr
 end
 
 """
@@ -30,9 +34,7 @@ Create an ADD for the i-th variable (0-1 valued).
 """
 function add_ith_var(mgr::DDManager, i::Int)
     @assert 1 <= i <= mgr.num_vars "Variable index out of range"
-    one_const = add_const(mgr, 1.0)
-    zero_const = add_const(mgr, 0.0)
-    return add_unique_lookup(mgr, i, one_const, zero_const)
+    return add_unique_lookup(mgr, i, mgr.one, mgr.add_zero)
 end
 
 """
@@ -46,77 +48,91 @@ function add_unique_lookup(mgr::DDManager, var_index::Int, then_child::NodeId, e
         return then_child
     end
 
-    level = mgr.perm[var_index]
-    table = mgr.unique_tables[level]
-
-    # Compute hash
-    h = hash_node(then_child, else_child, table.shift)
-    slot_idx = Int(((h - 1) % length(table.slots)) + 1)
-
-    # Search collision chain
-    node_idx = table.slots[slot_idx]
-    while node_idx != 0
-        node = mgr.nodes[node_idx]
-        if node.index == var_index &&
-           node.then_child == then_child &&
-           node.else_child == else_child
-            return NodeId(node_idx << 1)
-        end
-        node_idx = node.next
-    end
-
-    # Create new node
-    return create_node!(mgr, var_index, then_child, else_child, table, slot_idx)
+    return find_or_create_node!(mgr, var_index, then_child, else_child)
 end
 
 """
-    add_apply(mgr::DDManager, op::Function, f::NodeId, g::NodeId)
+    add_op_tag(mgr::DDManager, op)
 
-Apply a binary operation to two ADDs.
+Cache tag for an ADD operator. Built-in operators have fixed tags; any other
+callable gets a tag from the manager's registry on first use, which stays
+stable for that object (see [`register_add_op!`](@ref)).
+"""
+@inline add_op_tag(::DDManager, ::typeof(+)) = OP_ADD_PLUS
+@inline add_op_tag(::DDManager, ::typeof(-)) = OP_ADD_MINUS
+@inline add_op_tag(::DDManager, ::typeof(*)) = OP_ADD_TIMES
+@inline add_op_tag(::DDManager, ::typeof(/)) = OP_ADD_DIVIDE
+@inline add_op_tag(::DDManager, ::typeof(max)) = OP_ADD_MAX
+@inline add_op_tag(::DDManager, ::typeof(min)) = OP_ADD_MIN
+add_op_tag(mgr::DDManager, op) = register_add_op!(mgr, op)
 
-The operation function should take two Float64 values and return a Float64.
-Common operations: +, -, *, /, max, min
 """
-function add_apply(mgr::DDManager, op::Function, f::NodeId, g::NodeId)
-    # Terminal case: both are constants
-    f_node = get_node(mgr, f)
-    g_node = get_node(mgr, g)
+    add_shortcut(mgr::DDManager, op, f::NodeId, g::NodeId)
 
-    if is_terminal(f_node) && is_terminal(g_node)
-        result_value = op(f_node.value, g_node.value)
-        return add_const(mgr, result_value)
-    end
+Result of a built-in operator that follows from the operand ids alone
+(identities and absorbing constants, as in CUDD's `Cudd_addPlus` and
+friends), or `INVALID_NODE`. Like CUDD, `f * 0`, `f - f` and the like are
+taken to be 0 even if `f` has infinite or NaN terminals.
+"""
+@inline add_shortcut(::DDManager, op, ::NodeId, ::NodeId) = INVALID_NODE
 
-    # Generate operation tag
-    op_tag = OP_ADD_APPLY + hash(op) % 1000
+@inline function add_shortcut(mgr::DDManager, ::typeof(+), f::NodeId, g::NodeId)
+    f == mgr.add_zero && return g
+    g == mgr.add_zero && return f
+    return INVALID_NODE
+end
 
-    # Check cache
-    cached = cache_lookup(mgr, op_tag, f, g, UInt64(0))
-    if cached != INVALID_NODE
-        return cached
-    end
+@inline function add_shortcut(mgr::DDManager, ::typeof(-), f::NodeId, g::NodeId)
+    f == g && return mgr.add_zero
+    g == mgr.add_zero && return f
+    return INVALID_NODE
+end
 
-    # Find top variable
-    f_level = add_node_level(mgr, f)
-    g_level = add_node_level(mgr, g)
-    top_level = min(f_level, g_level)
+@inline function add_shortcut(mgr::DDManager, ::typeof(*), f::NodeId, g::NodeId)
+    (f == mgr.add_zero || g == mgr.add_zero) && return mgr.add_zero
+    f == mgr.one && return g
+    g == mgr.one && return f
+    return INVALID_NODE
+end
 
-    # Compute cofactors
-    fv, fnv = add_cofactors(mgr, f, f_level, top_level)
-    gv, gnv = add_cofactors(mgr, g, g_level, top_level)
+@inline function add_shortcut(mgr::DDManager, ::typeof(/), f::NodeId, g::NodeId)
+    g == mgr.one && return f
+    return INVALID_NODE
+end
+
+@inline add_shortcut(::DDManager, ::typeof(max), f::NodeId, g::NodeId) = f == g ? f : INVALID_NODE
+@inline add_shortcut(::DDManager, ::typeof(min), f::NodeId, g::NodeId) = f == g ? f : INVALID_NODE
 
-    # Recursive calls
-    t = add_apply(mgr, op, fv, gv)
-    e = add_apply(mgr, op, fnv, gnv)
+"""
+    register_add_op!(mgr::DDManager, op)
 
-    # Build result
-    var_index = mgr.invperm[top_level]
-    result = add_unique_lookup(mgr, var_index, t, e)
+Register a binary operator for use with [`add_apply`](@ref) and return its
+cache tag. Registration happens automatically on first use; the tag is keyed
+on the operator object itself, so a closure should be created once and reused
+rather than rebuilt for every call (each new non-isbits closure gets, and keeps,
+a fresh tag).
+"""
+function register_add_op!(mgr::DDManager, op)
+    return get!(mgr.op_tags, op) do
+        tag = mgr.next_op_tag
+        mgr.next_op_tag += 1
+        tag
+    end
+end
 
-    # Cache result
-    cache_insert!(mgr, op_tag, f, g, UInt64(0), result)
+"""
+    add_apply(mgr::DDManager, op, f::NodeId, g::NodeId)
 
-    return result
+Apply a binary operation to two ADDs.
+
+The operation takes two values of the manager's type `T` and its result is
+converted back to `T` (so `/` on a `DDManager{Int32}` must divide evenly).
+Common operations: +, -, *, /, max, min
+The operator's cache tag is resolved once per call and the apply engine is
+specialized on the operator's type.
+"""
+function add_apply(mgr::DDManager, op::F, f::NodeId, g::NodeId) where {F}
+    return apply_op(mgr, AddApply(op, add_op_tag(mgr, op)), f, g)
 end
 
 """
@@ -125,11 +141,7 @@ end
 Get the level of an ADD node (no complement edges for ADDs).
 """
 @inline function add_node_level(mgr::DDManager, id::NodeId)
-    node = get_node(mgr, id)
-    if is_terminal(node)
-        return typemax(Int)
-    end
-    return mgr.perm[node.index]
+    return node_level(mgr, id)
 end
 
 """
@@ -139,8 +151,7 @@ Compute cofactors for ADD (no complement edge handling).
 """
 @inline function add_cofactors(mgr::DDManager, f::NodeId, f_level::Int, top_level::Int)
     if f_level == top_level
-        node = get_node(mgr, f)
-        return node.then_child, node.else_child
+        return raw_then(mgr, f), raw_else(mgr, f)
     else
         return f, f
     end
@@ -189,11 +200,11 @@ Compute minimum of two ADDs (pointwise).
 add_min(mgr::DDManager, f::NodeId, g::NodeId) = add_apply(mgr, min, f, g)
 
 """
-    add_scalar_multiply(mgr::DDManager, f::NodeId, scalar::Float64)
+    add_scalar_multiply(mgr::DDManager, f::NodeId, scalar::Real)
 
 Multiply an ADD by a scalar constant.
 """
-function add_scalar_multiply(mgr::DDManager, f::NodeId, scalar::Float64)
+function add_scalar_multiply(mgr::DDManager, f::NodeId, scalar::Real)
     scalar_node = add_const(mgr, scalar)
     return add_times(mgr, f, scalar_node)
 end
@@ -204,27 +215,28 @@ end
 Negate an ADD (multiply by -1).
 """
 function add_negate(mgr::DDManager, f::NodeId)
-    return add_scalar_multiply(mgr, f, -1.0)
+    return add_scalar_multiply(mgr, f, -1)
 end
 
 """
-    add_threshold(mgr::DDManager, f::NodeId, threshold::Float64)
+    add_threshold(mgr::DDManager, f::NodeId, threshold::Real)
 
 Convert ADD to BDD by thresholding: result is 1 where f >= threshold, 0 otherwise.
-"""
-function add_threshold(mgr::DDManager, f::NodeId, threshold::Float64)
-    node = get_node(mgr, f)
-
-    # Terminal case
-    if is_terminal(node)
-        return node.value >= threshold ? mgr.one : mgr.zero
+Each node of `f` is visited once, bottom-up, comparing the terminal values
+in the manager's value type.
+"""
+function add_threshold(mgr::DDManager, f::NodeId, threshold::Real)
+    is_terminal(mgr, f) && return terminal_value(mgr, f) >= threshold ? mgr.one : mgr.zero
+
+    store = mgr.nodes
+    result = Dict{Int,NodeId}()
+    edge(id) = is_terminal(mgr, id) ? (terminal_value(mgr, id) >= threshold ? mgr.one : mgr.zero) :
+                                      result[node_slot(id)]
+    @inbounds for idx in bottom_up_slots(mgr, (f,))
+        result[idx] = unique_lookup(mgr, Int(store.index[idx]), edge(store.then_child[idx]),
+                                    edge(store.else_child[idx]))
     end
-
-    # Recursive case
-    t = add_threshold(mgr, node.then_child, threshold)
-    e = add_threshold(mgr, node.else_child, threshold)
-
-    return unique_lookup(mgr, Int(node.index), t, e)
+    return result[node_slot(f)]
 end
 
 """
@@ -233,28 +245,273 @@ end
 Restrict an ADD by setting a variable to a constant value.
 """
 function add_restrict(mgr::DDManager, f::NodeId, var::Int, value::Bool)
-    node = get_node(mgr, f)
+    return apply_op_args(mgr, AddRestrict(), f, var, value)
+end
+
+struct AddRestrict <: ApplyOp end
+
+@inline apply_tag(::AddRestrict) = OP_ADD_RESTRICT
+@inline apply_build(mgr::DDManager, ::AddRestrict, var::Int, t::NodeId, e::NodeId) =
+    add_unique_lookup(mgr, var, t, e)
 
+@inline function apply_step!(mgr::DDManager, op::AddRestrict, st::ApplyStacks,
+                             f::NodeId, var_arg::NodeId, value::NodeId)
     # Terminal case
-    if is_terminal(node)
-        return f
+    if is_terminal(mgr, f)
+        return push_result!(st, f)
     end
 
-    if node.index == var
+    var = Int(var_arg)
+    index = Int(node_index(mgr, f))
+    if index == var
         # This is the variable we're restricting
-        if value
-            return node.then_child
-        else
-            return node.else_child
-        end
-    elseif mgr.perm[node.index] < mgr.perm[var]
-        # Variable is above the restriction variable
-        t = add_restrict(mgr, node.then_child, var, value)
-        e = add_restrict(mgr, node.else_child, var, value)
-        return add_unique_lookup(mgr, Int(node.index), t, e)
-    else
+        return push_result!(st, value != 0 ? raw_then(mgr, f) : raw_else(mgr, f))
+    elseif mgr.perm[index] > mgr.perm[var]
         # Variable is below the restriction variable
-        return f
+        return push_result!(st, f)
+    end
+
+    # Variable is above the restriction variable
+    cached = cache_lookup(mgr, OP_ADD_RESTRICT, f, var_arg, value)
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+    push_build!(st, f, var_arg, value, index)
+    push_expand!(st, raw_else(mgr, f), var_arg, value)
+    push_expand!(st, raw_then(mgr, f), var_arg, value)
+end
+
+"""
+    add_permute(mgr::DDManager, f::NodeId, permut::AbstractVector{<:Integer})
+
+Rename every variable `i` of the ADD `f` to `permut[i]`, like CUDD's
+`Cudd_addPermute`. `permut` must be a permutation of `1:mgr.num_vars`.
+
+The nodes of `f` are rebuilt bottom-up in one pass, with the results kept
+for this call only. While the renaming keeps the relative order of the
+variables of `f`, each node goes straight into the unique table; a node
+whose new variable lands below variables of its rebuilt children is moved
+down to its place by a cached pass of the apply engine.
+"""
+function add_permute(mgr::DDManager, f::NodeId, permut::AbstractVector{<:Integer})
+    check_permutation(mgr, permut)
+    return with_node_limit(() -> add_permute_pass(mgr, f, permut), mgr, (f,))
+end
+
+function add_permute_pass(mgr::DDManager, f::NodeId, permut::AbstractVector{<:Integer})
+    store = mgr.nodes
+    result = Dict{Int,NodeId}()
+    edge(id) = is_terminal(mgr, id) ? id : result[node_slot(id)]
+    @inbounds for idx in bottom_up_slots(mgr, (f,))
+        var = Int(permut[store.index[idx]])
+        result[idx] = add_var_ite(mgr, var, edge(store.then_child[idx]), edge(store.else_child[idx]))
+    end
+    return edge(f)
+end
+
+"""
+    add_var_ite(mgr::DDManager, var::Int, t::NodeId, e::NodeId)
+
+The ADD that is `t` where variable `var` is 1 and `e` where it is 0.
+"""
+function add_var_ite(mgr::DDManager, var::Int, t::NodeId, e::NodeId)
+    t == e && return t
+    level = mgr.perm[var]
+    if level < add_node_level(mgr, t) && level < add_node_level(mgr, e)
+        return add_unique_lookup(mgr, var, t, e)
+    end
+    return run_apply(mgr, AddVarIte(), t, e, UInt64(var))
+end
+
+# Operands (t, e, var)
+struct AddVarIte <: ApplyOp end
+
+@inline apply_tag(::AddVarIte) = OP_ADD_VAR_ITE
+@inline apply_build(mgr::DDManager, ::AddVarIte, var::Int, t::NodeId, e::NodeId) =
+    add_unique_lookup(mgr, var, t, e)
+
+@inline function apply_step!(mgr::DDManager, op::AddVarIte, st::ApplyStacks,
+                             t::NodeId, e::NodeId, var_arg::NodeId)
+    t == e && return push_result!(st, t)
+    var = Int(var_arg)
+    level = mgr.perm[var]
+    t_level = add_node_level(mgr, t)
+    e_level = add_node_level(mgr, e)
+    top_level = min(t_level, e_level)
+    level < top_level && return push_result!(st, add_unique_lookup(mgr, var, t, e))
+
+    cached = cache_lookup(mgr, OP_ADD_VAR_ITE, t, e, var_arg)
+    cached != INVALID_NODE && return push_result!(st, cached)
+
+    if level == top_level
+        # Only the matching cofactors can be reached
+        tv, _ = add_cofactors(mgr, t, t_level, level)
+        _, en = add_cofactors(mgr, e, e_level, level)
+        result = add_unique_lookup(mgr, var, tv, en)
+        cache_insert!(mgr, OP_ADD_VAR_ITE, t, e, var_arg, result)
+        return push_result!(st, result)
+    end
+
+    tv, tnv = add_cofactors(mgr, t, t_level, top_level)
+    ev, env = add_cofactors(mgr, e, e_level, top_level)
+    push_build!(st, t, e, var_arg, mgr.invperm[top_level])
+    push_expand!(st, tnv, env, var_arg)
+    push_expand!(st, tv, ev, var_arg)
+end
+
+"""
+    add_abstract(mgr::DDManager, op, tag::UInt64, f::NodeId, cube::NodeId)
+
+Combine the two cofactors of `f` with `op` for every variable of the BDD
+`cube`, in one pass over `f`. A cube variable that `f` does not test has
+equal cofactors, so it contributes `op(r, r)` of the rest `r`. `op` must
+be associative and commutative with `op(0, 0) == 0`.
+"""
+function add_abstract(mgr::DDManager, op::F, tag::UInt64, f::NodeId, cube::NodeId) where {F}
+    return apply_op(mgr, AddAbstract(op, tag), f, cube)
+end
+
+# Operands (f, cube); `op` combines the cofactors under `tag`
+struct AddAbstract{F} <: ApplyOp
+    op::F
+    tag::UInt64
+end
+
+@inline apply_tag(op::AddAbstract) = op.tag
+@inline apply_build(mgr::DDManager, ::AddAbstract, var::Int, t::NodeId, e::NodeId) =
+    add_unique_lookup(mgr, var, t, e)
+@inline apply_combine(mgr::DDManager, op::AddAbstract, t::NodeId, e::NodeId) =
+    add_apply(mgr, op.op, t, e)
+
+@inline function apply_step!(mgr::DDManager, op::AddAbstract, st::ApplyStacks,
+                             f::NodeId, cube::NodeId, ::NodeId)
+    (cube == mgr.one || f == mgr.add_zero) && return push_result!(st, f)
+
+    cached = cache_lookup(mgr, op.tag, f, cube, UInt64(0))
+    cached != INVALID_NODE && return push_result!(st, cached)
+
+    f_level = add_node_level(mgr, f)
+    cube_level = node_level(mgr, cube)
+    if cube_level < f_level
+        push_build!(st, f, cube, UInt64(0), FRAME_COMBINE_SELF)
+        push_expand!(st, f, then_child(mgr, cube))
+    elseif cube_level == f_level
+        rest = then_child(mgr, cube)
+        push_build!(st, f, cube, UInt64(0), FRAME_COMBINE)
+        push_expand!(st, raw_else(mgr, f), rest)
+        push_expand!(st, raw_then(mgr, f), rest)
+    else
+        push_build!(st, f, cube, UInt64(0), mgr.invperm[f_level])
+        push_expand!(st, raw_else(mgr, f), cube)
+        push_expand!(st, raw_then(mgr, f), cube)
+    end
+end
+
+add_abstract(mgr::DDManager, op::F, tag::UInt64, f::NodeId, vars::Vector{Int}) where {F} =
+    isempty(vars) ? f : add_abstract(mgr, op, tag, f, bdd_cube(mgr, vars))
+
+"""
+    add_exist_abstract(mgr::DDManager, f::NodeId, cube::NodeId)
+    add_exist_abstract(mgr::DDManager, f::NodeId, vars::Vector{Int})
+
+Sum `f` over all values of the variables: `f[v=0] + f[v=1]` for each
+variable of the cube (see [`bdd_cube`](@ref)), like CUDD's
+`Cudd_addExistAbstract`. All variables are summed out in one pass over `f`;
+a variable `f` does not depend on doubles the result.
+"""
+add_exist_abstract(mgr::DDManager, f::NodeId, cube::Union{NodeId,Vector{Int}}) =
+    add_abstract(mgr, +, OP_ADD_EXIST_ABSTRACT, f, cube)
+
+"""
+    add_univ_abstract(mgr::DDManager, f::NodeId, cube::NodeId)
+    add_univ_abstract(mgr::DDManager, f::NodeId, vars::Vector{Int})
+
+Multiply `f` over all values of the variables: `f[v=0] * f[v=1]` for each
+variable of the cube, like CUDD's `Cudd_addUnivAbstract`.
+"""
+add_univ_abstract(mgr::DDManager, f::NodeId, cube::Union{NodeId,Vector{Int}}) =
+    add_abstract(mgr, *, OP_ADD_UNIV_ABSTRACT, f, cube)
+
+"""
+    add_max_abstract(mgr::DDManager, f::NodeId, cube::NodeId)
+    add_max_abstract(mgr::DDManager, f::NodeId, vars::Vector{Int})
+
+Maximize `f` over the variables of the cube: `max(f[v=0], f[v=1])` for each.
+"""
+add_max_abstract(mgr::DDManager, f::NodeId, cube::Union{NodeId,Vector{Int}}) =
+    add_abstract(mgr, max, OP_ADD_MAX_ABSTRACT, f, cube)
+
+"""
+    add_min_abstract(mgr::DDManager, f::NodeId, cube::NodeId)
+    add_min_abstract(mgr::DDManager, f::NodeId, vars::Vector{Int})
+
+Minimize `f` over the variables of the cube: `min(f[v=0], f[v=1])` for each.
+"""
+add_min_abstract(mgr::DDManager, f::NodeId, cube::Union{NodeId,Vector{Int}}) =
+    add_abstract(mgr, min, OP_ADD_MIN_ABSTRACT, f, cube)
+
+"""
+    add_matrix_multiply(mgr::DDManager, A::NodeId, B::NodeId, z::NodeId)
+    add_matrix_multiply(mgr::DDManager, A::NodeId, B::NodeId, z::Vector{Int})
+
+Matrix product of two ADDs: the sum of `A * B` over the variables `z`,
+given as a cube or a vector. With `A` a matrix over row variables `x` and
+the `z`, and `B` one over the `z` and column variables `y`, the result is
+`A·B` over `x` and `y`, as in CUDD's `Cudd_addMatrixMultiply`.
+
+Products and sums are taken in one recursion, like
+[`bdd_and_exists`](@ref), so the pointwise product `A * B` (which depends
+on all of `x`, `y` and `z`) is never built.
+"""
+function add_matrix_multiply(mgr::DDManager, A::NodeId, B::NodeId, z::NodeId)
+    return apply_op(mgr, AddMatrixMultiply(), A, B, z)
+end
+
+function add_matrix_multiply(mgr::DDManager, A::NodeId, B::NodeId, z::Vector{Int})
+    return add_matrix_multiply(mgr, A, B, bdd_cube(mgr, z))
+end
+
+struct AddMatrixMultiply <: ApplyOp end
+
+@inline apply_tag(::AddMatrixMultiply) = OP_ADD_MATRIX_MULTIPLY
+@inline apply_build(mgr::DDManager, ::AddMatrixMultiply, var::Int, t::NodeId, e::NodeId) =
+    add_unique_lookup(mgr, var, t, e)
+@inline apply_combine(mgr::DDManager, ::AddMatrixMultiply, t::NodeId, e::NodeId) =
+    add_plus(mgr, t, e)
+
+@inline function apply_step!(mgr::DDManager, op::AddMatrixMultiply, st::ApplyStacks,
+                             f::NodeId, g::NodeId, cube::NodeId)
+    (f == mgr.add_zero || g == mgr.add_zero) && return push_result!(st, mgr.add_zero)
+    cube == mgr.one && return push_result!(st, add_times(mgr, f, g))
+
+    # Normalize: the product is commutative
+    if f > g
+        f, g = g, f
+    end
+
+    cached = cache_lookup(mgr, OP_ADD_MATRIX_MULTIPLY, f, g, cube)
+    cached != INVALID_NODE && return push_result!(st, cached)
+
+    f_level = add_node_level(mgr, f)
+    g_level = add_node_level(mgr, g)
+    top_level = min(f_level, g_level)
+    cube_level = node_level(mgr, cube)
+    if cube_level < top_level
+        push_build!(st, f, g, cube, FRAME_COMBINE_SELF)
+        return push_expand!(st, f, g, then_child(mgr, cube))
+    end
+
+    fv, fnv = add_cofactors(mgr, f, f_level, top_level)
+    gv, gnv = add_cofactors(mgr, g, g_level, top_level)
+    if cube_level == top_level
+        rest = then_child(mgr, cube)
+        push_build!(st, f, g, cube, FRAME_COMBINE)
+        push_expand!(st, fnv, gnv, rest)
+        push_expand!(st, fv, gv, rest)
+    else
+        push_build!(st, f, g, cube, mgr.invperm[top_level])
+        push_expand!(st, fnv, gnv, cube)
+        push_expand!(st, fv, gv, cube)
     end
 end
 
@@ -265,52 +522,154 @@ Evaluate an ADD given a complete variable assignment.
 Returns the terminal value.
 """
 function add_eval(mgr::DDManager, f::NodeId, assignment::Dict{Int,Bool})
-    node = get_node(mgr, f)
-
-    while !is_terminal(node)
-        if get(assignment, node.index, false)
+    while !is_terminal(mgr, f)
+        node = get_node(mgr, f)
+        if get(assignment, Int(node.index), false)
             f = node.then_child
         else
             f = node.else_child
         end
-        node = get_node(mgr, f)
     end
 
-    return node.value
+    return terminal_value(mgr, f)
 end
 
 """
-    add_find_max(mgr::DDManager, f::NodeId)
+    compile_add(mgr::DDManager, f::NodeId)
 
-Find the maximum terminal value in an ADD.
+Copy the ADD `f` into a [`CompiledADD`](@ref): flat arrays of variables and
+child numbers, in level order, plus the terminal values. The compiled form
+does not refer to the manager, so it stays valid after garbage collection
+or reordering and can be shared between threads.
 """
-function add_find_max(mgr::DDManager, f::NodeId)
-    node = get_node(mgr, f)
+function compile_add(mgr::DDManager, f::NodeId)
+    store = mgr.nodes
+    internal = Int[]
+    terminals = Int[]
+    number = Dict{Int,Int32}()
+
+    # Collect the reachable slots
+    stack = [node_slot(f)]
+    seen = Set{Int}(stack)
+    @inbounds while !isempty(stack)
+        idx = pop!(stack)
+        if store.index[idx] == TERMINAL_INDEX
+            push!(terminals, idx)
+            continue
+        end
+        push!(internal, idx)
+        for child in (store.then_child[idx], store.else_child[idx])
+            c = node_slot(child)
+            if !(c in seen)
+                push!(seen, c)
+                push!(stack, c)
+            end
+        end
+    end
 
-    if is_terminal(node)
-        return node.value
+    # Number internal nodes by level (the root comes first), terminals by <= 0
+    sort!(internal; by = idx -> mgr.perm[store.index[idx]])
+    for (k, idx) in enumerate(internal)
+        number[idx] = Int32(k)
+    end
+    for (k, idx) in enumerate(terminals)
+        number[idx] = Int32(1 - k)
     end
 
-    max_then = add_find_max(mgr, node.then_child)
-    max_else = add_find_max(mgr, node.else_child)
+    n = length(internal)
+    var = Vector{Int32}(undef, n)
+    then_child = Vector{Int32}(undef, n)
+    else_child = Vector{Int32}(undef, n)
+    @inbounds for (k, idx) in enumerate(internal)
+        var[k] = Int32(store.index[idx])
+        then_child[k] = number[node_slot(store.then_child[idx])]
+        else_child[k] = number[node_slot(store.else_child[idx])]
+    end
+    values = [slot_value(mgr, idx) for idx in terminals]
+    num_vars = n == 0 ? 0 : Int(maximum(var))
 
-    return max(max_then, max_else)
+    return CompiledADD(var, then_child, else_child, values, number[node_slot(f)], num_vars)
+end
+
+# Walk one assignment (row `r` of `X`) down a compiled ADD
+@inline function eval_row(cf::CompiledADD, X::AbstractMatrix{Bool}, r::Int)
+    c = cf.root
+    @inbounds while c > 0
+        c = X[r, cf.var[c]] ? cf.then_child[c] : cf.else_child[c]
+    end
+    return @inbounds cf.values[1 - c]
 end
 
 """
-    add_find_min(mgr::DDManager, f::NodeId)
+    add_eval_batch!(out::AbstractVector, cf::CompiledADD, X::AbstractMatrix{Bool};
+                    threaded::Bool = false)
 
-Find the minimum terminal value in an ADD.
+Evaluate the compiled ADD on every row of `X` (row `r` assigns `X[r, i]` to
+variable `i`) and store the values in `out`. Nothing is allocated per row.
+With `threaded = true` the rows are split into chunks, one task per thread.
 """
-function add_find_min(mgr::DDManager, f::NodeId)
-    node = get_node(mgr, f)
+function add_eval_batch!(out::AbstractVector, cf::CompiledADD,
+                         X::AbstractMatrix{Bool}; threaded::Bool = false)
+    nrows = size(X, 1)
+    length(out) == nrows ||
+        throw(DimensionMismatch("output has length $(length(out)), expected $nrows"))
+    size(X, 2) >= cf.num_vars ||
+        throw(DimensionMismatch("assignments have $(size(X, 2)) columns, the ADD tests variable $(cf.num_vars)"))
 
-    if is_terminal(node)
-        return node.value
+    if threaded && Threads.nthreads() > 1 && nrows > 1
+        chunk = cld(nrows, Threads.nthreads())
+        Threads.@threads for first in 1:chunk:nrows
+            for r in first:min(first + chunk - 1, nrows)
+                @inbounds out[r] = eval_row(cf, X, r)
+            end
+        end
+    else
+        for r in 1:nrows
+            @inbounds out[r] = eval_row(cf, X, r)
+        end
     end
+    return out
+end
 
-    min_then = add_find_min(mgr, node.then_child)
-    min_else = add_find_min(mgr, node.else_child)
+"""
+    add_eval_batch(mgr::DDManager, f::NodeId, X::AbstractMatrix{Bool}; threaded::Bool = false)
+    add_eval_batch(cf::CompiledADD, X::AbstractMatrix{Bool}; threaded::Bool = false)
 
-    return min(min_then, min_else)
+Evaluate an ADD on many complete assignments at once: row `r` of `X` (a
+`BitMatrix` or `Matrix{Bool}`) assigns `X[r, i]` to variable `i`, and
+element `r` of the result is the value of `f` under it.
+The first form compiles `f` with [`compile_add`](@ref) first; compile once
+and use the second form when scoring several batches against one ADD.
+See [`add_eval_batch!`](@ref) for the threaded mode.
+"""
+function add_eval_batch(cf::CompiledADD{T}, X::AbstractMatrix{Bool}; threaded::Bool = false) where {T}
+    out = Vector{T}(undef, size(X, 1))
+    return add_eval_batch!(out, cf, X; threaded = threaded)
 end
+
+function add_eval_batch(mgr::DDManager, f::NodeId, X::AbstractMatrix{Bool}; threaded::Bool = false)
+    return add_eval_batch(compile_add(mgr, f), X; threaded = threaded)
+end
+
+# Values of the terminals reachable from f, each once
+function reachable_values(mgr::DDManager, f::NodeId)
+    store = mgr.nodes
+    return (slot_value(mgr, idx) for idx in reachable_slots(mgr, (f,))
+            if @inbounds store.index[idx] == TERMINAL_INDEX)
+end
+
+"""
+    add_find_max(mgr::DDManager{T}, f::NodeId)
+
+Find the maximum terminal value in an ADD, as a `T`. Every node is
+visited once.
+"""
+add_find_max(mgr::DDManager, f::NodeId) = maximum(reachable_values(mgr, f))
+
+"""
+    add_find_min(mgr::DDManager{T}, f::NodeId)
+
+Find the minimum terminal value in an ADD, as a `T`. Every node is
+visited once.
+"""
+add_find_min(mgr::DDManager, f::NodeId) = minimum(reachable_values(mgr, f))
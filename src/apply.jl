@@ -0,0 +1,408 @@
+# Iterative apply engine shared by the BDD, ADD and ZDD operators
+#
+# Operations are driven from an explicit frame stack instead of the Julia
+# call stack. An expand frame cofactors its operands and pushes a build frame
+# followed by the expand frames of its subproblems; a build frame pops the
+# subresults, makes the node and caches it. Each operator is a singleton type
+# whose `apply_step!` method is its recursive body with the recursive calls
+# replaced by pushes, so the engine specializes per operator.
+
+abstract type ApplyOp end
+
+struct BddAnd <: ApplyOp end
+struct BddOr <: ApplyOp end
+struct BddXor <: ApplyOp end
+struct BddIte <: ApplyOp end
+
+struct AddApply{F} <: ApplyOp
+    op::F
+    tag::UInt64
+end
+
+struct ZddUnion <: ApplyOp end
+struct ZddIntersect <: ApplyOp end
+struct ZddDiff <: ApplyOp end
+
+@inline apply_tag(::BddAnd) = OP_AND
+@inline apply_tag(::BddOr) = OP_OR
+@inline apply_tag(::BddXor) = OP_XOR
+@inline apply_tag(::BddIte) = OP_ITE
+@inline apply_tag(op::AddApply) = op.tag
+@inline apply_tag(::ZddUnion) = OP_ZDD_UNION
+@inline apply_tag(::ZddIntersect) = OP_ZDD_INTERSECT
+@inline apply_tag(::ZddDiff) = OP_ZDD_DIFF
+
+@inline apply_build(mgr::DDManager, ::Union{BddAnd,BddOr,BddXor,BddIte}, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
+@inline apply_build(mgr::DDManager, ::AddApply, var::Int, t::NodeId, e::NodeId) =
+    add_unique_lookup(mgr, var, t, e)
+@inline apply_build(mgr::DDManager, ::Union{ZddUnion,ZddIntersect,ZddDiff}, var::Int, t::NodeId, e::NodeId) =
+    zdd_unique_lookup(mgr, var, t, e)
+
+@inline push_expand!(st::ApplyStacks, f::NodeId, g::NodeId, h::NodeId = UInt64(0)) =
+    push!(st.frames, ApplyFrame(f, g, h, FRAME_EXPAND))
+@inline push_build!(st::ApplyStacks, f::NodeId, g::NodeId, h::NodeId, var::Int) =
+    push!(st.frames, ApplyFrame(f, g, h, var))
+@inline push_result!(st::ApplyStacks, r::NodeId) = push!(st.results, r)
+@inline push_complement!(st::ApplyStacks) =
+    push!(st.frames, ApplyFrame(UInt64(0), UInt64(0), UInt64(0), FRAME_NOT))
+
+# Second result of a FRAME_COMBINE, and whether a first result makes it moot
+@inline push_expand_rhs!(st::ApplyStacks, f::NodeId, g::NodeId, h::NodeId = UInt64(0)) =
+    push!(st.frames, ApplyFrame(f, g, h, FRAME_EXPAND_RHS))
+@inline apply_absorbs(mgr::DDManager, ::ApplyOp, r::NodeId) = false
+
+"""
+    apply_op(mgr::DDManager, op::ApplyOp, f::NodeId, g::NodeId, h::NodeId = 0)
+
+Run `op` on its operands with the iterative engine. The manager's stacks are
+reused between calls; the engine only works above the stack depth it found,
+so it is reentrant. Threaded managers use fresh stacks per call.
+Under a node limit the call goes through [`with_node_limit`](@ref).
+"""
+@inline function apply_op(mgr::DDManager, op::O, f::NodeId, g::NodeId,
+                          h::NodeId = UInt64(0)) where {O<:ApplyOp}
+    return with_node_limit(() -> run_apply(mgr, op, f, g, h), mgr, (f, g, h))
+end
+
+function run_apply(mgr::DDManager, op::O, f::NodeId, g::NodeId, h::NodeId) where {O<:ApplyOp}
+    st = mgr.threaded ? ApplyStacks() : mgr.apply_stacks
+    frames, results = st.frames, st.results
+    fbase, rbase = length(frames), length(results)
+    push_expand!(st, f, g, h)
+    try
+        while length(frames) > fbase
+            frame = pop!(frames)
+            kind = frame.var
+            if kind == FRAME_EXPAND
+                apply_step!(mgr, op, st, frame.f, frame.g, frame.h)
+            elseif kind == FRAME_EXPAND_RHS
+                first = results[end]
+                if apply_absorbs(mgr, op, first)
+                    push!(results, first)
+                else
+                    apply_step!(mgr, op, st, frame.f, frame.g, frame.h)
+                end
+            elseif kind == FRAME_NOT
+                push!(results, complement(pop!(results)))
+            else
+                e = pop!(results)
+                r = kind > 0 ? apply_build(mgr, op, kind, pop!(results), e) :
+                    kind == FRAME_COMBINE ? apply_combine(mgr, op, pop!(results), e) :
+                    kind == FRAME_COMBINE_SELF ? apply_combine(mgr, op, e, e) : e
+                cache_insert!(mgr, apply_tag(op), frame.f, frame.g, frame.h, r)
+                push!(results, r)
+            end
+        end
+    catch
+        resize!(frames, fbase)
+        resize!(results, rbase)
+        rethrow()
+    end
+    return pop!(results)
+end
+
+"""
+    apply_op_args(mgr::DDManager, op::ApplyOp, f::NodeId, a::Integer, b::Integer = 0)
+
+Run `op` on the diagram `f` and up to two integers (a variable, a value),
+which ride in the frames' other operand fields and so key the cache too.
+Only `f` is protected under a node limit.
+"""
+@inline function apply_op_args(mgr::DDManager, op::O, f::NodeId, a::Integer,
+                               b::Integer = 0) where {O<:ApplyOp}
+    return with_node_limit(() -> run_apply(mgr, op, f, UInt64(a), UInt64(b)), mgr, (f,))
+end
+
+# Shared expansion of the binary BDD operators on commutative operands
+@inline function bdd_binary_step!(mgr::DDManager, op::ApplyOp, st::ApplyStacks,
+                                  f::NodeId, g::NodeId)
+    # Normalize: ensure f <= g for commutativity
+    if f > g
+        f, g = g, f
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, apply_tag(op), f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+    top_level = min(f_level, g_level)
+
+    # Compute cofactors
+    fv, fnv = cofactors(mgr, f, f_level, top_level)
+    gv, gnv = cofactors(mgr, g, g_level, top_level)
+
+    # Then-branch runs first, so its result lies below the else result
+    push_build!(st, f, g, UInt64(0), mgr.invperm[top_level])
+    push_expand!(st, fnv, gnv)
+    push_expand!(st, fv, gv)
+end
+
+@inline function apply_step!(mgr::DDManager, op::BddAnd, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Terminal cases
+    if f == mgr.zero || g == mgr.zero || f == complement(g)
+        return push_result!(st, mgr.zero)
+    end
+    if f == mgr.one || f == g
+        return push_result!(st, g)
+    end
+    if g == mgr.one
+        return push_result!(st, f)
+    end
+    bdd_binary_step!(mgr, op, st, f, g)
+end
+
+@inline function apply_step!(mgr::DDManager, op::BddOr, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Terminal cases
+    if f == mgr.one || g == mgr.one || f == complement(g)
+        return push_result!(st, mgr.one)
+    end
+    if f == mgr.zero || f == g
+        return push_result!(st, g)
+    end
+    if g == mgr.zero
+        return push_result!(st, f)
+    end
+    bdd_binary_step!(mgr, op, st, f, g)
+end
+
+@inline function apply_step!(mgr::DDManager, op::BddXor, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Terminal cases
+    if f == mgr.zero
+        return push_result!(st, g)
+    end
+    if g == mgr.zero
+        return push_result!(st, f)
+    end
+    if f == mgr.one
+        return push_result!(st, complement(g))
+    end
+    if g == mgr.one
+        return push_result!(st, complement(f))
+    end
+    if f == g
+        return push_result!(st, mgr.zero)
+    end
+    if f == complement(g)
+        return push_result!(st, mgr.one)
+    end
+    bdd_binary_step!(mgr, op, st, f, g)
+end
+
+@inline function apply_step!(mgr::DDManager, op::BddIte, st::ApplyStacks,
+                             f::NodeId, g::NodeId, h::NodeId)
+    # ITE(f, f, h) = ITE(f, 1, h) and ITE(f, g, f) = ITE(f, g, 0)
+    if f == g
+        g = mgr.one
+    elseif f == h
+        h = mgr.zero
+    end
+
+    # Terminal cases
+    if f == mgr.one
+        return push_result!(st, g)
+    end
+    if f == mgr.zero
+        return push_result!(st, h)
+    end
+    if g == h
+        return push_result!(st, g)
+    end
+    if g == mgr.one && h == mgr.zero
+        return push_result!(st, f)
+    end
+    if g == mgr.zero && h == mgr.one
+        return push_result!(st, complement(f))
+    end
+
+    # Normalize: if f is complemented, swap g and h and complement f
+    if is_complemented(f)
+        f = complement(f)
+        g, h = h, g
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_ITE, f, g, h)
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+    h_level = node_level(mgr, h)
+    top_level = min(f_level, g_level, h_level)
+
+    # Compute cofactors
+    fv, fnv = cofactors(mgr, f, f_level, top_level)
+    gv, gnv = cofactors(mgr, g, g_level, top_level)
+    hv, hnv = cofactors(mgr, h, h_level, top_level)
+
+    push_build!(st, f, g, h, mgr.invperm[top_level])
+    push_expand!(st, fnv, gnv, hnv)
+    push_expand!(st, fv, gv, hv)
+end
+
+@inline function apply_step!(mgr::DDManager, op::AddApply, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Identities and absorbing constants of built-in operators
+    shortcut = add_shortcut(mgr, op.op, f, g)
+    if shortcut != INVALID_NODE
+        return push_result!(st, shortcut)
+    end
+
+    # Terminal case: both are constants
+    if is_terminal(mgr, f) && is_terminal(mgr, g)
+        result_value = op.op(terminal_value(mgr, f), terminal_value(mgr, g))
+        return push_result!(st, add_const(mgr, result_value))
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, op.tag, f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    # Find top variable
+    f_level = add_node_level(mgr, f)
+    g_level = add_node_level(mgr, g)
+    top_level = min(f_level, g_level)
+
+    # Compute cofactors
+    fv, fnv = add_cofactors(mgr, f, f_level, top_level)
+    gv, gnv = add_cofactors(mgr, g, g_level, top_level)
+
+    push_build!(st, f, g, UInt64(0), mgr.invperm[top_level])
+    push_expand!(st, fnv, gnv)
+    push_expand!(st, fv, gv)
+end
+
+@inline function apply_step!(mgr::DDManager, op::ZddUnion, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Terminal cases
+    zdd_zero = zdd_empty(mgr)
+    if f == zdd_zero || f == g
+        return push_result!(st, g)
+    end
+    if g == zdd_zero
+        return push_result!(st, f)
+    end
+
+    # Normalize: ensure f <= g for commutativity
+    if f > g
+        f, g = g, f
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_ZDD_UNION, f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+
+    if f_level < g_level
+        # g doesn't have f's variable, so all sets in g go to the else-branch
+        push_build!(st, f, g, UInt64(0), Int(node_index(mgr, f)))
+        push_result!(st, raw_then(mgr, f))
+        push_expand!(st, raw_else(mgr, f), g)
+    elseif f_level > g_level
+        push_build!(st, f, g, UInt64(0), Int(node_index(mgr, g)))
+        push_result!(st, raw_then(mgr, g))
+        push_expand!(st, f, raw_else(mgr, g))
+    else
+        # Same variable
+        push_build!(st, f, g, UInt64(0), Int(node_index(mgr, f)))
+        push_expand!(st, raw_else(mgr, f), raw_else(mgr, g))
+        push_expand!(st, raw_then(mgr, f), raw_then(mgr, g))
+    end
+end
+
+@inline function apply_step!(mgr::DDManager, op::ZddIntersect, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Terminal cases
+    zdd_zero = zdd_empty(mgr)
+    if f == zdd_zero || g == zdd_zero
+        return push_result!(st, zdd_zero)
+    end
+    if f == g
+        return push_result!(st, f)
+    end
+
+    # Normalize
+    if f > g
+        f, g = g, f
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_ZDD_INTERSECT, f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+
+    if f_level < g_level
+        # Only sets without f's variable can be in g
+        push_build!(st, f, g, UInt64(0), FRAME_PASS)
+        push_expand!(st, raw_else(mgr, f), g)
+    elseif f_level > g_level
+        push_build!(st, f, g, UInt64(0), FRAME_PASS)
+        push_expand!(st, f, raw_else(mgr, g))
+    else
+        # Same variable - both must have it or both must not have it
+        push_build!(st, f, g, UInt64(0), Int(node_index(mgr, f)))
+        push_expand!(st, raw_else(mgr, f), raw_else(mgr, g))
+        push_expand!(st, raw_then(mgr, f), raw_then(mgr, g))
+    end
+end
+
+@inline function apply_step!(mgr::DDManager, op::ZddDiff, st::ApplyStacks,
+                             f::NodeId, g::NodeId, ::NodeId)
+    # Terminal cases
+    zdd_zero = zdd_empty(mgr)
+    if f == zdd_zero || f == g
+        return push_result!(st, zdd_zero)
+    end
+    if g == zdd_zero
+        return push_result!(st, f)
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_ZDD_DIFF, f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+
+    if f_level < g_level
+        # No set of g has f's variable: those of f are all kept
+        push_build!(st, f, g, UInt64(0), Int(node_index(mgr, f)))
+        push_result!(st, raw_then(mgr, f))
+        push_expand!(st, raw_else(mgr, f), g)
+    elseif f_level > g_level
+        # No set of f has g's variable: only g's other sets can remove any
+        push_build!(st, f, g, UInt64(0), FRAME_PASS)
+        push_expand!(st, f, raw_else(mgr, g))
+    else
+        # Same variable
+        push_build!(st, f, g, UInt64(0), Int(node_index(mgr, f)))
+        push_expand!(st, raw_else(mgr, f), raw_else(mgr, g))
+        push_expand!(st, raw_then(mgr, f), raw_then(mgr, g))
+    end
+end
@@ -23,65 +23,7 @@ expressed in terms of ITE:
 - NOT(f) = ITE(f, 0, 1)
 """
 function bdd_ite(mgr::DDManager, f::NodeId, g::NodeId, h::NodeId)
-    # Terminal cases
-    if f == mgr.one
-        return g
-    end
-    if f == mgr.zero
-        return h
-    end
-    if g == h
-        return g
-    end
-    if g == mgr.one && h == mgr.zero
-        return f
-    end
-    if g == mgr.zero && h == mgr.one
-        return complement(f)
-    end
-    if f == g
-        return bdd_or(mgr, f, h)
-    end
-    if f == h
-        return bdd_and(mgr, f, g)
-    end
-
-    # Normalize: ensure canonical form
-    # If f is complemented, swap g and h and complement f
-    if is_complemented(f)
-        f = complement(f)
-        g, h = h, g
-    end
-
-    # Check cache
-    cached = cache_lookup(mgr, OP_ITE, f, g, h)
-    if cached != INVALID_NODE
-        return cached
-    end
-
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-    h_level = node_level(mgr, h)
-    top_level = min(f_level, g_level, h_level)
-
-    # Compute cofactors
-    fv, fnv = cofactors(mgr, f, f_level, top_level)
-    gv, gnv = cofactors(mgr, g, g_level, top_level)
-    hv, hnv = cofactors(mgr, h, h_level, top_level)
-
-    # Recursive calls
-    t = bdd_ite(mgr, fv, gv, hv)
-    e = bdd_ite(mgr, fnv, gnv, hnv)
-
-    # Build result
-    var_index = mgr.invperm[top_level]
-    result = unique_lookup(mgr, var_index, t, e)
-
-    # Cache result
-    cache_insert!(mgr, OP_ITE, f, g, h, result)
-
-    return result
+    return apply_op(mgr, BddIte(), f, g, h)
 end
 
 """
@@ -103,259 +45,715 @@ end
 Compute the conjunction (AND) of two BDDs.
 """
 function bdd_and(mgr::DDManager, f::NodeId, g::NodeId)
-    # Terminal cases
-    if f == mgr.zero || g == mgr.zero
-        return mgr.zero
-    end
-    if f == mgr.one
-        return g
-    end
-    if g == mgr.one
-        return f
-    end
-    if f == g
-        return f
-    end
-    if f == complement(g)
-        return mgr.zero
-    end
+    return apply_op(mgr, BddAnd(), f, g)
+end
 
-    # Normalize: ensure f <= g for commutativity
-    if f > g
-        f, g = g, f
-    end
+"""
+    bdd_or(mgr::DDManager, f::NodeId, g::NodeId)
 
-    # Check cache
-    cached = cache_lookup(mgr, OP_AND, f, g, UInt64(0))
-    if cached != INVALID_NODE
-        return cached
-    end
+Compute the disjunction (OR) of two BDDs.
+"""
+function bdd_or(mgr::DDManager, f::NodeId, g::NodeId)
+    return apply_op(mgr, BddOr(), f, g)
+end
 
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-    top_level = min(f_level, g_level)
+"""
+    bdd_xor(mgr::DDManager, f::NodeId, g::NodeId)
 
-    # Compute cofactors
-    fv, fnv = cofactors(mgr, f, f_level, top_level)
-    gv, gnv = cofactors(mgr, g, g_level, top_level)
+Compute the exclusive-or (XOR) of two BDDs.
+"""
+function bdd_xor(mgr::DDManager, f::NodeId, g::NodeId)
+    return apply_op(mgr, BddXor(), f, g)
+end
 
-    # Recursive calls
-    t = bdd_and(mgr, fv, gv)
-    e = bdd_and(mgr, fnv, gnv)
+"""
+    bdd_not(mgr::DDManager, f::NodeId)
 
-    # Build result
-    var_index = mgr.invperm[top_level]
-    result = unique_lookup(mgr, var_index, t, e)
+Compute the negation (NOT) of a BDD.
+For BDDs with complement edges, this is just a pointer complement.
+"""
+@inline bdd_not(mgr::DDManager, f::NodeId) = complement(f)
 
-    # Cache result
-    cache_insert!(mgr, OP_AND, f, g, UInt64(0), result)
+"""
+    bdd_restrict(mgr::DDManager, f::NodeId, var::Int, value::Bool)
 
-    return result
+Restrict a BDD by setting a variable to a constant value.
+This is also known as the cofactor operation.
+"""
+function bdd_restrict(mgr::DDManager, f::NodeId, var::Int, value::Bool)
+    return apply_op_args(mgr, BddCofactor(), f, var, value)
 end
 
-"""
-    bdd_or(mgr::DDManager, f::NodeId, g::NodeId)
+struct BddCofactor <: ApplyOp end
 
-Compute the disjunction (OR) of two BDDs.
-"""
-function bdd_or(mgr::DDManager, f::NodeId, g::NodeId)
-    # Terminal cases
-    if f == mgr.one || g == mgr.one
-        return mgr.one
-    end
-    if f == mgr.zero
-        return g
-    end
-    if g == mgr.zero
-        return f
-    end
-    if f == g
-        return f
-    end
-    if f == complement(g)
-        return mgr.one
-    end
+@inline apply_tag(::BddCofactor) = OP_COFACTOR
+@inline apply_build(mgr::DDManager, ::BddCofactor, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
 
-    # Normalize: if both are complemented, use De Morgan's law
-    # ¬f ∨ ¬g = ¬(f ∧ g)
-    if is_complemented(f) && is_complemented(g)
-        return complement(bdd_and(mgr, complement(f), complement(g)))
+@inline function apply_step!(mgr::DDManager, op::BddCofactor, st::ApplyStacks,
+                             f::NodeId, var_arg::NodeId, value::NodeId)
+    # Terminal case
+    if is_terminal(mgr, f)
+        return push_result!(st, f)
     end
 
-    # Normalize: ensure f <= g for commutativity
-    if f > g
-        f, g = g, f
+    var = Int(var_arg)
+    index = Int(node_index(mgr, f))
+    if index == var
+        # This is the variable we're restricting
+        return push_result!(st, value != 0 ? then_child(mgr, f) : else_child(mgr, f))
+    elseif mgr.perm[index] > mgr.perm[var]
+        # Variable is below the restriction variable
+        return push_result!(st, f)
     end
 
-    # Check cache
-    cached = cache_lookup(mgr, OP_OR, f, g, UInt64(0))
+    # Variable is above the restriction variable. Normalize: the cofactor of
+    # ¬f is the complement of the cofactor of f
+    comp = is_complemented(f)
+    f = regular(f)
+    cached = cache_lookup(mgr, OP_COFACTOR, f, var_arg, value)
     if cached != INVALID_NODE
-        return cached
+        return push_result!(st, comp ? complement(cached) : cached)
     end
 
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-    top_level = min(f_level, g_level)
+    comp && push_complement!(st)
+    push_build!(st, f, var_arg, value, index)
+    push_expand!(st, else_child(mgr, f), var_arg, value)
+    push_expand!(st, then_child(mgr, f), var_arg, value)
+end
 
-    # Compute cofactors
-    fv, fnv = cofactors(mgr, f, f_level, top_level)
-    gv, gnv = cofactors(mgr, g, g_level, top_level)
+# f ≤ g, i.e. f → g
+bdd_leq(mgr::DDManager, f::NodeId, g::NodeId) = bdd_and(mgr, f, complement(g)) == mgr.zero
 
-    # Recursive calls
-    t = bdd_or(mgr, fv, gv)
-    e = bdd_or(mgr, fnv, gnv)
+"""
+    bdd_constrain(mgr::DDManager, f::NodeId, c::NodeId)
+
+Generalized cofactor `f ↓ c` of Coudert and Madre, like CUDD's
+`Cudd_bddConstrain`: a function that agrees with `f` wherever the care set
+`c` holds, chosen by mapping each point outside `c` to its nearest point
+in `c`. Where `c` has only one branch at a node the other is dropped, so
+the result is often, but not always, smaller than `f`. Constrain
+distributes over the Boolean operators and `bdd_constrain(mgr, f, c) ∧ c
+== f ∧ c`. A zero care set gives zero.
+"""
+function bdd_constrain(mgr::DDManager, f::NodeId, c::NodeId)
+    return apply_op(mgr, BddConstrain(), f, c)
+end
 
-    # Build result
-    var_index = mgr.invperm[top_level]
-    result = unique_lookup(mgr, var_index, t, e)
+struct BddConstrain <: ApplyOp end
 
-    # Cache result
-    cache_insert!(mgr, OP_OR, f, g, UInt64(0), result)
+@inline apply_tag(::BddConstrain) = OP_CONSTRAIN
+@inline apply_build(mgr::DDManager, ::BddConstrain, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
 
-    return result
+@inline function apply_step!(mgr::DDManager, op::BddConstrain, st::ApplyStacks,
+                             f::NodeId, c::NodeId, ::NodeId)
+    # Terminal cases
+    c == mgr.one && return push_result!(st, f)
+    c == mgr.zero && return push_result!(st, mgr.zero)
+    is_terminal(mgr, f) && return push_result!(st, f)
+    f == c && return push_result!(st, mgr.one)
+    f == complement(c) && return push_result!(st, mgr.zero)
+
+    # Normalize: f ↓ c for ¬f is the complement of the result for f
+    comp = is_complemented(f)
+    f = regular(f)
+
+    cached = cache_lookup(mgr, OP_CONSTRAIN, f, c, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, comp ? complement(cached) : cached)
+    end
+
+    f_level = node_level(mgr, f)
+    c_level = node_level(mgr, c)
+    top_level = min(f_level, c_level)
+    fv, fnv = cofactors(mgr, f, f_level, top_level)
+    cv, cnv = cofactors(mgr, c, c_level, top_level)
+
+    comp && push_complement!(st)
+    if cv == mgr.zero
+        push_build!(st, f, c, UInt64(0), FRAME_PASS)
+        push_expand!(st, fnv, cnv)
+    elseif cnv == mgr.zero
+        push_build!(st, f, c, UInt64(0), FRAME_PASS)
+        push_expand!(st, fv, cv)
+    else
+        push_build!(st, f, c, UInt64(0), mgr.invperm[top_level])
+        push_expand!(st, fnv, cnv)
+        push_expand!(st, fv, cv)
+    end
 end
 
 """
-    bdd_xor(mgr::DDManager, f::NodeId, g::NodeId)
-
-Compute the exclusive-or (XOR) of two BDDs.
+    bdd_restrict(mgr::DDManager, f::NodeId, c::NodeId)
+
+Coudert and Madre's restrict operator against the care set `c`, like
+CUDD's `Cudd_bddRestrict`: a function that agrees with `f` wherever `c`
+holds. Unlike [`bdd_constrain`](@ref), variables of `c` that `f` does not
+test are first quantified out of `c`, so the result only depends on
+variables of `f`. If it still comes out larger than `f`, `f` is returned.
+A zero care set gives zero.
 """
-function bdd_xor(mgr::DDManager, f::NodeId, g::NodeId)
-    # Terminal cases
-    if f == mgr.zero
-        return g
+function bdd_restrict(mgr::DDManager, f::NodeId, c::NodeId)
+    result = apply_op(mgr, BddRestrict(), f, c)
+    return count_nodes(mgr, result) <= count_nodes(mgr, f) ? result : f
+end
+
+struct BddRestrict <: ApplyOp end
+
+@inline apply_tag(::BddRestrict) = OP_RESTRICT
+@inline apply_build(mgr::DDManager, ::BddRestrict, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
+
+@inline function apply_step!(mgr::DDManager, op::BddRestrict, st::ApplyStacks,
+                             f::NodeId, c::NodeId, ::NodeId)
+    c == mgr.zero && return push_result!(st, mgr.zero)
+    is_terminal(mgr, f) && return push_result!(st, f)
+
+    # Quantify out the care-set variables above f
+    f_level = node_level(mgr, f)
+    while node_level(mgr, c) < f_level
+        c = bdd_or(mgr, then_child(mgr, c), else_child(mgr, c))
     end
-    if g == mgr.zero
-        return f
+    c == mgr.one && return push_result!(st, f)
+    f == c && return push_result!(st, mgr.one)
+    f == complement(c) && return push_result!(st, mgr.zero)
+
+    comp = is_complemented(f)
+    f = regular(f)
+
+    cached = cache_lookup(mgr, OP_RESTRICT, f, c, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, comp ? complement(cached) : cached)
     end
-    if f == mgr.one
-        return complement(g)
+
+    fv, fnv = then_child(mgr, f), else_child(mgr, f)
+    cv, cnv = cofactors(mgr, c, node_level(mgr, c), f_level)
+
+    comp && push_complement!(st)
+    if cv == mgr.zero
+        push_build!(st, f, c, UInt64(0), FRAME_PASS)
+        push_expand!(st, fnv, cnv)
+    elseif cnv == mgr.zero
+        push_build!(st, f, c, UInt64(0), FRAME_PASS)
+        push_expand!(st, fv, cv)
+    else
+        push_build!(st, f, c, UInt64(0), mgr.invperm[f_level])
+        push_expand!(st, fnv, cnv)
+        push_expand!(st, fv, cv)
     end
-    if g == mgr.one
-        return complement(f)
+end
+
+# Edge marks of LI compaction: which values the diagram below an edge takes
+# on the care set. NL (both) also marks an edge into an internal node.
+const LIC_DC = 0x00
+const LIC_1 = 0x01
+const LIC_0 = 0x02
+const LIC_NL = 0x03
+
+"""
+    bdd_li_compaction(mgr::DDManager, f::NodeId, c::NodeId)
+
+Safe minimization of `f` against the care set `c`, after Hong et al. and
+CUDD's `Cudd_bddLICompaction`: the result agrees with `f` wherever `c`
+holds and is never larger than `f`. A first pass marks, for every node of
+`f`, which of its edges any path within `c` ever takes; a node one of
+whose edges is never taken is then replaced by its other child.
+"""
+function bdd_li_compaction(mgr::DDManager, f::NodeId, c::NodeId)
+    c == mgr.zero && return mgr.zero
+    return with_node_limit(mgr, (f, c)) do
+        marks = Dict{Int,UInt8}()
+        lic_mark!(marks, mgr, f, c)
+        lic_build(mgr, marks, f)
     end
-    if f == g
-        return mgr.zero
+end
+
+# Frames of the marking pass: expand (f, c), or combine the marks of its two
+# subproblems, at a node of f or where c splits above f
+const LIC_EXPAND = 0
+const LIC_NODE = 1
+const LIC_SPLIT = 2
+
+# Mark the edges of f's nodes that paths within c take; return the mark of
+# an edge into f. Runs on an explicit stack, memoizing the mark of each (f, c).
+function lic_mark!(marks::Dict{Int,UInt8}, mgr::DDManager, f::NodeId, c::NodeId)
+    memo = Dict{Tuple{NodeId,NodeId},UInt8}()
+    frames = [(f, c, LIC_EXPAND)]
+    results = UInt8[]
+    while !isempty(frames)
+        f, c, kind = pop!(frames)
+        if kind != LIC_EXPAND
+            e = pop!(results)
+            t = pop!(results)
+            if kind == LIC_NODE
+                slot = node_slot(f)
+                marks[slot] = get(marks, slot, LIC_DC) | t << 2 | e
+                mark = LIC_NL
+            else
+                mark = t | e
+            end
+            memo[(f, c)] = mark
+            push!(results, mark)
+            continue
+        end
+
+        if c == mgr.zero
+            push!(results, LIC_DC)
+        elseif f == mgr.one
+            push!(results, LIC_1)
+        elseif f == mgr.zero
+            push!(results, LIC_0)
+        elseif haskey(memo, (f, c))
+            push!(results, memo[(f, c)])
+        else
+            f_level = node_level(mgr, f)
+            c_level = node_level(mgr, c)
+            top_level = min(f_level, c_level)
+            cv, cnv = cofactors(mgr, c, c_level, top_level)
+            if f_level <= c_level
+                fv, fnv = cofactors(mgr, f, f_level, top_level)
+                push!(frames, (f, c, LIC_NODE), (fnv, cnv, LIC_EXPAND), (fv, cv, LIC_EXPAND))
+            else
+                # c splits above f: both of its branches reach f itself
+                push!(frames, (f, c, LIC_SPLIT), (f, cnv, LIC_EXPAND), (f, cv, LIC_EXPAND))
+            end
+        end
     end
-    if f == complement(g)
-        return mgr.one
+    return pop!(results)
+end
+
+# Result of the edge `id` once its node is rebuilt
+@inline function lic_result(mgr::DDManager, result::Dict{Int,NodeId}, id::NodeId)
+    is_terminal(mgr, id) && return id
+    r = result[node_slot(id)]
+    return is_complemented(id) ? complement(r) : r
+end
+
+@inline lic_pending(mgr::DDManager, result::Dict{Int,NodeId}, id::NodeId) =
+    !is_terminal(mgr, id) && !haskey(result, node_slot(id))
+
+# Rebuild f without the edges no path within the care set takes; a node stays
+# on the stack until the children it keeps are rebuilt
+function lic_build(mgr::DDManager, marks::Dict{Int,UInt8}, f::NodeId)
+    is_terminal(mgr, f) && return f
+    result = Dict{Int,NodeId}()
+    store = mgr.nodes
+    stack = [node_slot(f)]
+    while !isempty(stack)
+        slot = stack[end]
+        if haskey(result, slot)
+            pop!(stack)
+            continue
+        end
+        mark = get(marks, slot, LIC_DC)
+        t, e = store.then_child[slot], store.else_child[slot]
+        keep_t = mark >> 2 != LIC_DC
+        keep_e = !keep_t || mark & 0x03 != LIC_DC
+        pending = false
+        if keep_t && lic_pending(mgr, result, t)
+            push!(stack, node_slot(t))
+            pending = true
+        end
+        if keep_e && lic_pending(mgr, result, e)
+            push!(stack, node_slot(e))
+            pending = true
+        end
+        pending && continue
+
+        pop!(stack)
+        result[slot] = !keep_t ? lic_result(mgr, result, e) :
+                       !keep_e ? lic_result(mgr, result, t) :
+                       unique_lookup(mgr, Int(store.index[slot]), lic_result(mgr, result, t),
+                                     lic_result(mgr, result, e))
     end
+    return lic_result(mgr, result, f)
+end
 
-    # Normalize
-    if f > g
-        f, g = g, f
+"""
+    bdd_squeeze(mgr::DDManager, l::NodeId, u::NodeId)
+
+A small BDD `f` with `l ≤ f ≤ u`, like CUDD's `Cudd_bddSqueeze`: where the
+interval allows a function independent of a variable, the variable is
+dropped, else both branches are squeezed. The result is never larger than
+`l` or `u`. Squeezing `f ∧ c` and `f ∨ ¬c` minimizes `f` against the care
+set `c`.
+"""
+function bdd_squeeze(mgr::DDManager, l::NodeId, u::NodeId)
+    bdd_leq(mgr, l, u) || throw(ArgumentError("the lower bound is not contained in the upper bound"))
+    result = apply_op(mgr, BddSqueeze(), l, u)
+    sizes = (count_nodes(mgr, result), count_nodes(mgr, l), count_nodes(mgr, u))
+    return (result, l, u)[argmin(sizes)]
+end
+
+struct BddSqueeze <: ApplyOp end
+
+@inline apply_tag(::BddSqueeze) = OP_SQUEEZE
+@inline apply_build(mgr::DDManager, ::BddSqueeze, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
+
+@inline function apply_step!(mgr::DDManager, op::BddSqueeze, st::ApplyStacks,
+                             l::NodeId, u::NodeId, ::NodeId)
+    l == u && return push_result!(st, l)
+    l == mgr.zero && return push_result!(st, l)
+    u == mgr.one && return push_result!(st, u)
+
+    # Normalize: l ≤ f ≤ u exactly when ¬u ≤ ¬f ≤ ¬l; keep the pair with the smaller lower bound
+    if complement(u) < l
+        push_complement!(st)
+        return push_expand!(st, complement(u), complement(l))
     end
 
-    # Check cache
-    cached = cache_lookup(mgr, OP_XOR, f, g, UInt64(0))
-    if cached != INVALID_NODE
-        return cached
+    cached = cache_lookup(mgr, OP_SQUEEZE, l, u, UInt64(0))
+    cached != INVALID_NODE && return push_result!(st, cached)
+
+    l_level = node_level(mgr, l)
+    u_level = node_level(mgr, u)
+    top_level = min(l_level, u_level)
+    lv, lnv = cofactors(mgr, l, l_level, top_level)
+    uv, unv = cofactors(mgr, u, u_level, top_level)
+
+    if bdd_leq(mgr, lv, unv) && bdd_leq(mgr, lnv, uv)
+        # One function fits both branches
+        push_build!(st, l, u, UInt64(0), FRAME_PASS)
+        push_expand!(st, bdd_or(mgr, lv, lnv), bdd_and(mgr, uv, unv))
+    else
+        push_build!(st, l, u, UInt64(0), mgr.invperm[top_level])
+        push_expand!(st, lnv, unv)
+        push_expand!(st, lv, uv)
     end
+end
 
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-    top_level = min(f_level, g_level)
+"""
+    bdd_vector_compose(mgr::DDManager, f::NodeId, vector::AbstractVector{NodeId})
 
-    # Compute cofactors
-    fv, fnv = cofactors(mgr, f, f_level, top_level)
-    gv, gnv = cofactors(mgr, g, g_level, top_level)
+Substitute `vector[i]` for every variable `i` of `f` at once, like CUDD's
+`Cudd_bddVectorCompose`; `vector[i] = ith_var(mgr, i)` leaves `i` alone.
 
-    # Recursive calls
-    t = bdd_xor(mgr, fv, gv)
-    e = bdd_xor(mgr, fnv, gnv)
+The nodes of `f` are rebuilt bottom-up in one pass, each from the results
+for its children, with the results kept for this call only. A node whose
+variable is replaced by a projection `ith_var(mgr, j)` with `j` above both
+rebuilt children becomes a node on `j` directly; any other node costs one
+[`bdd_ite`](@ref).
+"""
+function bdd_vector_compose(mgr::DDManager, f::NodeId, vector::AbstractVector{NodeId})
+    length(vector) == mgr.num_vars ||
+        throw(ArgumentError("the vector must hold one function per variable ($(mgr.num_vars))"))
+    return with_node_limit(() -> compose_pass(mgr, f, vector), mgr, vcat(f, vector))
+end
 
-    # Build result
-    var_index = mgr.invperm[top_level]
-    result = unique_lookup(mgr, var_index, t, e)
+"""
+    bdd_permute(mgr::DDManager, f::NodeId, permut::AbstractVector{<:Integer})
 
-    # Cache result
-    cache_insert!(mgr, OP_XOR, f, g, UInt64(0), result)
+Rename every variable `i` of `f` to `permut[i]`, like CUDD's
+`Cudd_bddPermute`. `permut` must be a permutation of `1:mgr.num_vars`.
+When the renaming keeps the relative order of the variables of `f`, as
+shifting current-state to next-state variables usually does under an
+interleaved order, every node is rebuilt directly, without ITE.
+"""
+function bdd_permute(mgr::DDManager, f::NodeId, permut::AbstractVector{<:Integer})
+    check_permutation(mgr, permut)
+    vector = [ith_var(mgr, Int(v)) for v in permut]
+    return with_node_limit(() -> compose_pass(mgr, f, vector), mgr, (f,))
+end
+
+function check_permutation(mgr, permut::AbstractVector{<:Integer})
+    length(permut) == mgr.num_vars && isperm(permut) ||
+        throw(ArgumentError("not a permutation of the manager's $(mgr.num_vars) variables"))
+end
 
-    return result
+function compose_pass(mgr::DDManager, f::NodeId, vector::AbstractVector{NodeId})
+    store = mgr.nodes
+    result = Dict{Int,NodeId}()
+    edge(id) = is_terminal(mgr, id) ? id :
+               is_complemented(id) ? complement(result[node_slot(id)]) : result[node_slot(id)]
+    @inbounds for idx in bottom_up_slots(mgr, (f,))
+        g = vector[store.index[idx]]
+        t = edge(store.then_child[idx])
+        e = edge(store.else_child[idx])
+        result[idx] = compose_node(mgr, g, t, e)
+    end
+    return edge(f)
+end
+
+# ITE(g, t, e), straight from the unique table when g is a variable above t and e
+@inline function compose_node(mgr::DDManager, g::NodeId, t::NodeId, e::NodeId)
+    if !is_terminal(mgr, g) && then_child(mgr, g) == mgr.one && else_child(mgr, g) == mgr.zero
+        level = node_level(mgr, g)
+        if level < node_level(mgr, t) && level < node_level(mgr, e)
+            return unique_lookup(mgr, mgr.invperm[level], t, e)
+        end
+    end
+    return bdd_ite(mgr, g, t, e)
 end
 
 """
-    bdd_not(mgr::DDManager, f::NodeId)
+    bdd_cube(mgr::DDManager, vars::Vector{Int})
 
-Compute the negation (NOT) of a BDD.
-For BDDs with complement edges, this is just a pointer complement.
+Build the conjunction of the positive literals of `vars`, the form in which
+quantification and relational product take their variable sets.
 """
-@inline bdd_not(mgr::DDManager, f::NodeId) = complement(f)
+function bdd_cube(mgr::DDManager, vars::Vector{Int})
+    # Build bottom-up, deepest level first
+    cube = mgr.one
+    for var in sort(vars; by = v -> mgr.perm[v], rev = true)
+        @assert 1 <= var <= mgr.num_vars "Variable index out of range"
+        cube = unique_lookup(mgr, var, cube, mgr.zero)
+    end
+    return cube
+end
 
 """
-    bdd_restrict(mgr::DDManager, f::NodeId, var::Int, value::Bool)
+    bdd_from_cubes(mgr::DDManager, cubes)
 
-Restrict a BDD by setting a variable to a constant value.
-This is also known as the cofactor operation.
+Build the disjunction of a list of cubes. Each cube is a vector indexed by
+variable, with `1` for a positive literal, `0` for a negative one and any
+other value (`2` in [`bdd_cubes`](@ref)) for a variable left open.
+
+Each cube goes bottom-up straight into the unique tables. The cubes are
+then or-ed pairwise in a balanced tree, so no single accumulator has to
+absorb every cube in turn.
 """
-function bdd_restrict(mgr::DDManager, f::NodeId, var::Int, value::Bool)
-    # Terminal case
-    if f == mgr.zero || f == mgr.one
-        return f
-    end
+function bdd_from_cubes(mgr::DDManager, cubes::AbstractVector{<:AbstractVector{<:Integer}})
+    # The terms are not referenced, so a retry after a collection starts over
+    return with_node_limit(() -> build_from_cubes(mgr, cubes), mgr, ())
+end
 
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return f
+function build_from_cubes(mgr::DDManager, cubes::AbstractVector{<:AbstractVector{<:Integer}})
+    terms = Vector{NodeId}(undef, length(cubes))
+    for (k, cube) in enumerate(cubes)
+        length(cube) <= mgr.num_vars ||
+            throw(ArgumentError("cube has $(length(cube)) entries, the manager $(mgr.num_vars) variables"))
+        term = mgr.one
+        for level in mgr.num_vars:-1:1
+            var = mgr.invperm[level]
+            var <= length(cube) || continue
+            if cube[var] == 1
+                term = unique_lookup(mgr, var, term, mgr.zero)
+            elseif cube[var] == 0
+                term = unique_lookup(mgr, var, mgr.zero, term)
+            end
+        end
+        terms[k] = term
     end
 
-    if node.index == var
-        # This is the variable we're restricting
-        if value
-            return then_child(mgr, f)
-        else
-            return else_child(mgr, f)
+    # Balanced reduction, in place
+    n = length(terms)
+    while n > 1
+        for k in 1:n ÷ 2
+            terms[k] = bdd_or(mgr, terms[2k - 1], terms[2k])
         end
-    elseif mgr.perm[node.index] < mgr.perm[var]
-        # Variable is above the restriction variable
-        t = bdd_restrict(mgr, then_child(mgr, f), var, value)
-        e = bdd_restrict(mgr, else_child(mgr, f), var, value)
-        return unique_lookup(mgr, Int(node.index), t, e)
-    else
-        # Variable is below the restriction variable
-        return f
+        if isodd(n)
+            terms[n ÷ 2 + 1] = terms[n]
+        end
+        n = cld(n, 2)
+    end
+    return n == 0 ? mgr.zero : terms[1]
+end
+
+"""
+    bdd_from_truth_table(mgr::DDManager, table::AbstractVector{Bool}, vars = 1:log2(length(table)))
+
+Build the BDD over `vars` whose value is `table[i]` under the assignment
+that gives `vars[j]` bit `j - 1` of `i - 1`. So `vars[1]` is the least
+significant bit, and `length(table)` must be `2^length(vars)`.
+The diagram is built bottom-up with one unique-table lookup per node of the
+decision tree and no apply calls, in any variable order.
+"""
+function bdd_from_truth_table(mgr::DDManager, table::AbstractVector{Bool},
+                              vars::AbstractVector{<:Integer} = 1:trailing_zeros(length(table)))
+    length(vars) < 63 && length(table) == 1 << length(vars) ||
+        throw(ArgumentError("a truth table over $(length(vars)) variables needs 2^$(length(vars)) entries"))
+    allunique(vars) && all(v -> 1 <= v <= mgr.num_vars, vars) ||
+        throw(ArgumentError("variables must be distinct and within 1:$(mgr.num_vars)"))
+
+    # Branch on the variables from the top level down
+    order = sort(collect(eachindex(vars)); by = j -> mgr.perm[vars[j]])
+    return truth_table_rec(mgr, table, vars, order, 1, 0)
+end
+
+function truth_table_rec(mgr::DDManager, table::AbstractVector{Bool}, vars::AbstractVector{<:Integer},
+                         order::Vector{Int}, k::Int, index::Int)
+    if k > length(order)
+        return table[firstindex(table) + index] ? mgr.one : mgr.zero
+    end
+    j = order[k]
+    t = truth_table_rec(mgr, table, vars, order, k + 1, index | (1 << (j - 1)))
+    e = truth_table_rec(mgr, table, vars, order, k + 1, index)
+    return unique_lookup(mgr, Int(vars[j]), t, e)
+end
+
+"""
+    skip_cube(mgr::DDManager, cube::NodeId, level::Int)
+
+Drop the cube variables above `level`; a function that does not depend on
+them is unaffected by quantifying them.
+"""
+@inline function skip_cube(mgr::DDManager, cube::NodeId, level::Int)
+    while cube != mgr.one && node_level(mgr, cube) < level
+        cube = then_child(mgr, cube)
     end
+    return cube
 end
 
 """
+    bdd_exists(mgr::DDManager, f::NodeId, cube::NodeId)
     bdd_exists(mgr::DDManager, f::NodeId, vars::Vector{Int})
 
 Existential quantification: ∃vars. f = f[vars=0] ∨ f[vars=1]
+
+All variables of the cube (see [`bdd_cube`](@ref)) are quantified in a single
+pass over `f`.
 """
+function bdd_exists(mgr::DDManager, f::NodeId, cube::NodeId)
+    return apply_op(mgr, BddExists(), f, cube)
+end
+
+struct BddExists <: ApplyOp end
+
+@inline apply_tag(::BddExists) = OP_EXISTS
+@inline apply_build(mgr::DDManager, ::BddExists, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
+@inline apply_combine(mgr::DDManager, ::BddExists, t::NodeId, e::NodeId) = bdd_or(mgr, t, e)
+@inline apply_absorbs(mgr::DDManager, ::BddExists, r::NodeId) = r == mgr.one
+
+@inline function apply_step!(mgr::DDManager, op::BddExists, st::ApplyStacks,
+                             f::NodeId, cube::NodeId, ::NodeId)
+    # Terminal cases
+    if f == mgr.zero || f == mgr.one
+        return push_result!(st, f)
+    end
+
+    f_level = node_level(mgr, f)
+    cube = skip_cube(mgr, cube, f_level)
+    if cube == mgr.one
+        return push_result!(st, f)
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_EXISTS, f, cube, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
+    end
+
+    t = then_child(mgr, f)
+    e = else_child(mgr, f)
+
+    if node_level(mgr, cube) == f_level
+        # Quantified variable: OR the cofactors, the second unless the first is 1
+        rest = then_child(mgr, cube)
+        push_build!(st, f, cube, UInt64(0), FRAME_COMBINE)
+        push_expand_rhs!(st, e, rest)
+        push_expand!(st, t, rest)
+    else
+        push_build!(st, f, cube, UInt64(0), mgr.invperm[f_level])
+        push_expand!(st, e, cube)
+        push_expand!(st, t, cube)
+    end
+end
+
 function bdd_exists(mgr::DDManager, f::NodeId, vars::Vector{Int})
     if isempty(vars)
         return f
     end
-
-    # Quantify out one variable at a time
-    result = f
-    for var in vars
-        result = bdd_or(mgr,
-                       bdd_restrict(mgr, result, var, false),
-                       bdd_restrict(mgr, result, var, true))
-    end
-    return result
+    return bdd_exists(mgr, f, bdd_cube(mgr, vars))
 end
 
 """
+    bdd_forall(mgr::DDManager, f::NodeId, cube::NodeId)
     bdd_forall(mgr::DDManager, f::NodeId, vars::Vector{Int})
 
 Universal quantification: ∀vars. f = f[vars=0] ∧ f[vars=1]
+
+Computed as ¬∃vars. ¬f, sharing the cache entries of [`bdd_exists`](@ref).
 """
+function bdd_forall(mgr::DDManager, f::NodeId, cube::NodeId)
+    return complement(bdd_exists(mgr, complement(f), cube))
+end
+
 function bdd_forall(mgr::DDManager, f::NodeId, vars::Vector{Int})
     if isempty(vars)
         return f
     end
+    return bdd_forall(mgr, f, bdd_cube(mgr, vars))
+end
+
+"""
+    bdd_and_exists(mgr::DDManager, f::NodeId, g::NodeId, cube::NodeId)
+    bdd_and_exists(mgr::DDManager, f::NodeId, g::NodeId, vars::Vector{Int})
 
-    # Quantify out one variable at a time
-    result = f
-    for var in vars
-        result = bdd_and(mgr,
-                        bdd_restrict(mgr, result, var, false),
-                        bdd_restrict(mgr, result, var, true))
+Relational product: ∃vars. (f ∧ g), computed in one recursion without
+building the conjunction first (CUDD's `Cudd_bddAndAbstract`).
+"""
+function bdd_and_exists(mgr::DDManager, f::NodeId, g::NodeId, cube::NodeId)
+    return apply_op(mgr, BddAndExists(), f, g, cube)
+end
+
+struct BddAndExists <: ApplyOp end
+
+@inline apply_tag(::BddAndExists) = OP_AND_EXISTS
+@inline apply_build(mgr::DDManager, ::BddAndExists, var::Int, t::NodeId, e::NodeId) =
+    unique_lookup(mgr, var, t, e)
+@inline apply_combine(mgr::DDManager, ::BddAndExists, t::NodeId, e::NodeId) = bdd_or(mgr, t, e)
+@inline apply_absorbs(mgr::DDManager, ::BddAndExists, r::NodeId) = r == mgr.one
+
+@inline function apply_step!(mgr::DDManager, op::BddAndExists, st::ApplyStacks,
+                             f::NodeId, g::NodeId, cube::NodeId)
+    # Terminal cases
+    if f == mgr.zero || g == mgr.zero || f == complement(g)
+        return push_result!(st, mgr.zero)
+    end
+    if f == mgr.one && g == mgr.one
+        return push_result!(st, mgr.one)
+    end
+    if cube == mgr.one
+        return push_result!(st, bdd_and(mgr, f, g))
+    end
+    if f == mgr.one || f == g
+        return push_result!(st, run_apply(mgr, BddExists(), g, cube, UInt64(0)))
+    end
+    if g == mgr.one
+        return push_result!(st, run_apply(mgr, BddExists(), f, cube, UInt64(0)))
+    end
+
+    # Normalize: ensure f <= g for commutativity
+    if f > g
+        f, g = g, f
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+    top_level = min(f_level, g_level)
+
+    cube = skip_cube(mgr, cube, top_level)
+    if cube == mgr.one
+        return push_result!(st, bdd_and(mgr, f, g))
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_AND_EXISTS, f, g, cube)
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
     end
-    return result
+
+    # Compute cofactors
+    fv, fnv = cofactors(mgr, f, f_level, top_level)
+    gv, gnv = cofactors(mgr, g, g_level, top_level)
+
+    if node_level(mgr, cube) == top_level
+        # Quantified variable: OR the cofactor products, the second unless the first is 1
+        rest = then_child(mgr, cube)
+        push_build!(st, f, g, cube, FRAME_COMBINE)
+        push_expand_rhs!(st, fnv, gnv, rest)
+        push_expand!(st, fv, gv, rest)
+    else
+        push_build!(st, f, g, cube, mgr.invperm[top_level])
+        push_expand!(st, fnv, gnv, cube)
+        push_expand!(st, fv, gv, cube)
+    end
+end
+
+function bdd_and_exists(mgr::DDManager, f::NodeId, g::NodeId, vars::Vector{Int})
+    return bdd_and_exists(mgr, f, g, bdd_cube(mgr, vars))
 end
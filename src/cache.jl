@@ -5,21 +5,63 @@ const OP_AND = UInt64(1)
 const OP_OR = UInt64(2)
 const OP_XOR = UInt64(3)
 const OP_ITE = UInt64(4)
+const OP_EXISTS = UInt64(5)
+const OP_AND_EXISTS = UInt64(6)
+const OP_COFACTOR = UInt64(7)
+const OP_CONSTRAIN = UInt64(8)
+const OP_RESTRICT = UInt64(9)
+const OP_SQUEEZE = UInt64(10)
 const OP_ADD_APPLY = UInt64(100)  # Base for ADD operations
+const OP_ADD_PLUS = OP_ADD_APPLY + 1
+const OP_ADD_MINUS = OP_ADD_APPLY + 2
+const OP_ADD_TIMES = OP_ADD_APPLY + 3
+const OP_ADD_DIVIDE = OP_ADD_APPLY + 4
+const OP_ADD_MAX = OP_ADD_APPLY + 5
+const OP_ADD_MIN = OP_ADD_APPLY + 6
+const OP_ADD_RESTRICT = OP_ADD_APPLY + 7
+const OP_ADD_EXIST_ABSTRACT = OP_ADD_APPLY + 8
+const OP_ADD_UNIV_ABSTRACT = OP_ADD_APPLY + 9
+const OP_ADD_MAX_ABSTRACT = OP_ADD_APPLY + 10
+const OP_ADD_MIN_ABSTRACT = OP_ADD_APPLY + 11
+const OP_ADD_MATRIX_MULTIPLY = OP_ADD_APPLY + 12
+const OP_ADD_VAR_ITE = OP_ADD_APPLY + 13
 const OP_ZDD_UNION = UInt64(200)
 const OP_ZDD_INTERSECT = UInt64(201)
 const OP_ZDD_DIFF = UInt64(202)
+const OP_ZDD_SUBSET0 = UInt64(203)
+const OP_ZDD_SUBSET1 = UInt64(204)
+const OP_ZDD_CHANGE = UInt64(205)
+const OP_USER_BASE = UInt64(1) << 32  # First tag handed out to registered operators
 
 """
-    cache_hash(op::UInt64, f::NodeId, g::NodeId, h::UInt64, shift::Int)
+    cache_hash(op::UInt64, f::NodeId, g::NodeId, h::UInt64, nsets::Int)
 
-Hash function for computed table.
+Hash function for computed table. Returns a 1-based set index.
 """
-@inline function cache_hash(op::UInt64, f::NodeId, g::NodeId, h::UInt64, cache_size::Int)
+@inline function cache_hash(op::UInt64, f::NodeId, g::NodeId, h::UInt64, nsets::Int)
     hash_val = (op * HASH_P1 + f * HASH_P2 + g * HASH_P1 + h * HASH_P2)
-    return Int(((hash_val - 1) % cache_size) + 1)
+    return Int(((hash_val - 1) % nsets) + 1)
 end
 
+"""
+    cache_stat_slot(op::UInt64)
+
+Counter slot of an operation tag; all user-registered tags share the last slot.
+"""
+@inline cache_stat_slot(op::UInt64) = op < CACHE_STAT_SLOTS - 1 ? Int(op) + 1 : CACHE_STAT_SLOTS
+
+# Counter row of the running thread; a thread started after the manager shares the last row
+@inline function cache_stat_row(cache::ComputedTable)
+    rows = size(cache.lookups, 2)
+    return rows == 1 ? 1 : min(Threads.threadid(), rows)
+end
+
+@inline entry_matches(entry::CacheEntry, epoch::UInt32, op::UInt64, f::NodeId, g::NodeId, h::UInt64) =
+    entry.f == f && entry.g == g && entry.h == h && entry.op == op && entry.epoch == epoch
+
+# An entry holds a result unless it was never written or belongs to an old epoch
+@inline entry_live(entry::CacheEntry, epoch::UInt32) = entry.op != 0 && entry.epoch == epoch
+
 """
     cache_lookup(mgr::DDManager, op::UInt64, f::NodeId, g::NodeId, h::UInt64)
 
@@ -27,19 +69,103 @@ Look up a cached result for an operation.
 Returns INVALID_NODE if not found.
 """
 function cache_lookup(mgr::DDManager, op::UInt64, f::NodeId, g::NodeId, h::UInt64)
-    cache = mgr.cache
-    idx = cache_hash(op, f, g, h, length(cache.entries))
+    if mgr.threaded
+        lk = cache_lock(mgr, op, f, g, h)
+        lock(lk)
+        try
+            return table_lookup(mgr.cache, op, f, g, h)
+        finally
+            unlock(lk)
+        end
+    end
+    return table_lookup(mgr.cache, op, f, g, h)
+end
+
+# Lock stripe guarding the set an operation hashes to (threaded managers)
+@inline function cache_lock(mgr::DDManager, op::UInt64, f::NodeId, g::NodeId, h::UInt64)
+    set = cache_hash(op, f, g, h, mgr.cache.nsets)
+    locks = mgr.cache_locks
+    return @inbounds locks[((set - 1) & (length(locks) - 1)) + 1]
+end
 
-    entry = cache.entries[idx]
+@inline function table_lookup(cache::ComputedTable, op::UInt64, f::NodeId, g::NodeId, h::UInt64)
+    set = cache_hash(op, f, g, h, cache.nsets)
+    stat, row = cache_stat_slot(op), cache_stat_row(cache)
+    STATS_COMPILED && @inbounds cache.lookups[stat, row] += 1
+    cache.window_lookups += 1
 
-    # Check if entry matches (direct-mapped cache, so just check equality)
-    if entry.f == f && entry.g == g && entry.h == (h ⊻ op)
-        return entry.result
+    if cache.ways == 1
+        # Direct-mapped: a single candidate entry
+        entry = @inbounds cache.entries[set]
+        if entry_matches(entry, cache.epoch, op, f, g, h)
+            STATS_COMPILED && @inbounds cache.hits[stat, row] += 1
+            cache.window_hits += 1
+            return entry.result
+        end
+    else
+        base = (set - 1) * cache.ways
+        @inbounds for w in 1:cache.ways
+            entry = cache.entries[base + w]
+            if entry_matches(entry, cache.epoch, op, f, g, h)
+                cache.stamps[base + w] = cache.clock
+                STATS_COMPILED && (cache.hits[stat, row] += 1)
+                cache.window_hits += 1
+                return entry.result
+            end
+        end
     end
 
+    cache_miss!(cache)
     return INVALID_NODE
 end
 
+"""
+    cache_miss!(cache::ComputedTable)
+
+Growth policy, checked on every miss. Once the current window has seen more
+misses than the table has entries, the table doubles if the window's hit
+ratio exceeds `cache.min_hit` and `cache.max_size` allows it; otherwise a new
+window starts. Each doubling is paid for by at least `length(entries)` misses.
+A frozen table (during parallel operations) never grows.
+"""
+@inline function cache_miss!(cache::ComputedTable)
+    cache.frozen && return
+    size = length(cache.entries)
+    if cache.window_lookups - cache.window_hits > size
+        if 2 * size <= cache.max_size && cache.window_hits > cache.min_hit * cache.window_lookups
+            grow_cache!(cache)
+        else
+            cache.window_lookups = 0
+            cache.window_hits = 0
+        end
+    end
+end
+
+"""
+    grow_cache!(cache::ComputedTable)
+
+Double the number of entries, rehashing the valid ones into the new table.
+"""
+function grow_cache!(cache::ComputedTable)
+    old_entries = cache.entries
+    new_size = 2 * length(old_entries)
+
+    cache.entries = fill(CacheEntry(), new_size)
+    cache.stamps = cache.ways == 1 ? UInt32[] : zeros(UInt32, new_size)
+    cache.shift = 64 - trailing_zeros(new_size)
+    cache.nsets = new_size ÷ cache.ways
+
+    for entry in old_entries
+        if entry_live(entry, cache.epoch)
+            store_entry!(cache, entry, false)
+        end
+    end
+
+    cache.resizes += 1
+    cache.window_lookups = 0
+    cache.window_hits = 0
+end
+
 """
     cache_insert!(mgr::DDManager, op::UInt64, f::NodeId, g::NodeId, h::UInt64, result::NodeId)
 
@@ -47,19 +173,172 @@ Insert a result into the cache.
 """
 function cache_insert!(mgr::DDManager, op::UInt64, f::NodeId, g::NodeId, h::UInt64, result::NodeId)
     cache = mgr.cache
-    idx = cache_hash(op, f, g, h, length(cache.entries))
+    entry = CacheEntry(op, f, g, h, result, cache.epoch)
+    if mgr.threaded
+        lk = cache_lock(mgr, op, f, g, h)
+        lock(lk)
+        try
+            store_entry!(cache, entry, true)
+        finally
+            unlock(lk)
+        end
+        return
+    end
+    store_entry!(cache, entry, true)
+end
+
+function store_entry!(cache::ComputedTable, new_entry::CacheEntry, count::Bool)
+    op, f, g, h = new_entry.op, new_entry.f, new_entry.g, new_entry.h
+    set = cache_hash(op, f, g, h, cache.nsets)
+
+    if cache.ways == 1
+        # Direct-mapped: just overwrite
+        @inbounds if STATS_COMPILED && count && entry_live(cache.entries[set], cache.epoch)
+            cache.evictions[cache_stat_slot(cache.entries[set].op), cache_stat_row(cache)] += 1
+        end
+        @inbounds cache.entries[set] = new_entry
+        return
+    end
+
+    # Advance the aging clock; on wrap-around restart all stamps
+    cache.clock += UInt32(1)
+    if cache.clock == 0
+        fill!(cache.stamps, UInt32(0))
+        cache.clock = UInt32(1)
+    end
+
+    # Pick the matching way, else an empty way, else the least recently used
+    base = (set - 1) * cache.ways
+    victim = base + 1
+    @inbounds for w in 1:cache.ways
+        i = base + w
+        entry = cache.entries[i]
+        if !entry_live(entry, cache.epoch) || entry_matches(entry, cache.epoch, op, f, g, h)
+            victim = i
+            break
+        end
+        if cache.stamps[i] < cache.stamps[victim]
+            victim = i
+        end
+    end
 
-    # Direct-mapped: just overwrite
-    cache.entries[idx] = CacheEntry(f, g, h ⊻ op, result)
+    @inbounds begin
+        old = cache.entries[victim]
+        if STATS_COMPILED && count && entry_live(old, cache.epoch) &&
+           !entry_matches(old, cache.epoch, op, f, g, h)
+            cache.evictions[cache_stat_slot(old.op), cache_stat_row(cache)] += 1
+        end
+        cache.entries[victim] = new_entry
+        cache.stamps[victim] = cache.clock
+    end
+end
+
+"""
+    set_max_cache_size!(mgr::DDManager, max_size::Int)
+
+Set the number of entries the computed table may grow to, like CUDD's
+`Cudd_SetMaxCacheHard`. The table is never shrunk below its current size.
+"""
+function set_max_cache_size!(mgr::DDManager, max_size::Int)
+    max_size = max(max_size, length(mgr.cache.entries))
+    mgr.max_cache_size = max_size
+    mgr.cache.max_size = max_size
+    return mgr
 end
 
 """
     clear_cache!(mgr::DDManager)
 
-Clear all cache entries.
+Clear all cache entries. This advances the cache epoch, so it takes constant
+time; the entries are only rewritten when the epoch counter wraps around.
 """
 function clear_cache!(mgr::DDManager)
-    for i in eachindex(mgr.cache.entries)
-        mgr.cache.entries[i] = CacheEntry()
+    cache = mgr.cache
+    cache.epoch += UInt32(1)
+    if cache.epoch == 0
+        fill!(cache.entries, CacheEntry())
+        fill!(cache.stamps, UInt32(0))
+        cache.epoch = UInt32(1)
+    end
+end
+
+# Whether an operand or result word names a node slot that is not live.
+# Words that are not node ids (0, INVALID_NODE, scalar payloads out of range)
+# never match; a payload that happens to alias a dead id only costs an entry.
+@inline function names_dead(live::BitVector, id::UInt64)
+    slot = id >> 2
+    return 0 < slot <= length(live) && @inbounds !live[slot]
+end
+
+"""
+    invalidate_cache!(mgr::DDManager, live::BitVector)
+
+Drop the cache entries that mention a node slot not marked in `live`,
+keeping every other memoized result across a garbage collection.
+"""
+function invalidate_cache!(mgr::DDManager, live::BitVector)
+    cache = mgr.cache
+    epoch = cache.epoch
+    @inbounds for i in eachindex(cache.entries)
+        entry = cache.entries[i]
+        entry_live(entry, epoch) || continue
+        if names_dead(live, entry.f) || names_dead(live, entry.g) ||
+           names_dead(live, entry.h) || names_dead(live, entry.result)
+            cache.entries[i] = CacheEntry()
+        end
     end
 end
+
+# Names of the built-in operation tags, for reporting
+const OP_NAMES = Dict{UInt64,String}(
+    OP_AND => "AND", OP_OR => "OR", OP_XOR => "XOR", OP_ITE => "ITE",
+    OP_EXISTS => "EXISTS", OP_AND_EXISTS => "AND_EXISTS", OP_COFACTOR => "COFACTOR",
+    OP_CONSTRAIN => "CONSTRAIN", OP_RESTRICT => "RESTRICT", OP_SQUEEZE => "SQUEEZE",
+    OP_ADD_PLUS => "ADD_PLUS", OP_ADD_MINUS => "ADD_MINUS", OP_ADD_TIMES => "ADD_TIMES",
+    OP_ADD_DIVIDE => "ADD_DIVIDE", OP_ADD_MAX => "ADD_MAX", OP_ADD_MIN => "ADD_MIN",
+    OP_ADD_RESTRICT => "ADD_RESTRICT",
+    OP_ADD_EXIST_ABSTRACT => "ADD_EXIST_ABS", OP_ADD_UNIV_ABSTRACT => "ADD_UNIV_ABS",
+    OP_ADD_MAX_ABSTRACT => "ADD_MAX_ABS", OP_ADD_MIN_ABSTRACT => "ADD_MIN_ABS",
+    OP_ADD_MATRIX_MULTIPLY => "ADD_MATMUL", OP_ADD_VAR_ITE => "ADD_VAR_ITE",
+    OP_ZDD_UNION => "ZDD_UNION", OP_ZDD_INTERSECT => "ZDD_INTERSECT", OP_ZDD_DIFF => "ZDD_DIFF",
+    OP_ZDD_SUBSET0 => "ZDD_SUBSET0", OP_ZDD_SUBSET1 => "ZDD_SUBSET1", OP_ZDD_CHANGE => "ZDD_CHANGE",
+)
+
+op_name(slot::Int) = slot == CACHE_STAT_SLOTS ? "USER" :
+    get(OP_NAMES, UInt64(slot - 1), "OP_$(slot - 1)")
+
+"""
+    cache_stats(mgr::DDManager)
+
+Per-operation computed-table counters, one named tuple
+`(op, lookups, hits, misses, evictions)` per operation that has been used.
+Operators registered with [`register_add_op!`](@ref) are reported together as `"USER"`.
+"""
+function cache_stats(mgr::DDManager)
+    cache = mgr.cache
+    stats = NamedTuple{(:op, :lookups, :hits, :misses, :evictions),
+                       Tuple{String,Int,Int,Int,Int}}[]
+    for slot in 1:CACHE_STAT_SLOTS
+        lookups = sum(@view cache.lookups[slot, :])
+        evictions = sum(@view cache.evictions[slot, :])
+        if lookups > 0 || evictions > 0
+            hits = sum(@view cache.hits[slot, :])
+            push!(stats, (op = op_name(slot), lookups = lookups, hits = hits,
+                          misses = lookups - hits, evictions = evictions))
+        end
+    end
+    return stats
+end
+
+"""
+    reset_cache_stats!(mgr::DDManager)
+
+Zero the per-operation computed-table counters.
+"""
+function reset_cache_stats!(mgr::DDManager)
+    cache = mgr.cache
+    fill!(cache.lookups, 0)
+    fill!(cache.hits, 0)
+    fill!(cache.evictions, 0)
+    return mgr
+end
@@ -0,0 +1,490 @@
+# CUDD backend: the package's operations on a CUDD manager, through ccall
+#
+# A CuddManager wraps a DdManager* of the shared CUDD library. Node ids are
+# the DdNode pointers themselves: bit 0 is CUDD's complement bit, as in our
+# ids, and ZDD nodes also carry CUDD_ZDD_TAG (bit 1, free because nodes are
+# word-aligned) so that deref! knows which of CUDD's dereference functions
+# to call. The library is opened on first use, and every call site caches
+# its symbol, so a call costs one load and an indirect call.
+
+using Libdl
+
+const CUDD_ZDD_TAG = NodeId(0x02)
+
+# Cudd_ReorderingType values for the methods reduce_heap! accepts
+const CUDD_REORDER_METHODS = Dict(:sift => 4, :sift_converge => 5, :symm_sift => 6,
+                                  :window2 => 8, :window3 => 9, :window4 => 10,
+                                  :group_sift => 14, :annealing => 16, :genetic => 17,
+                                  :linear => 18, :exact => 21)
+
+# Cudd_ErrorType values
+const CUDD_MEMORY_OUT = 1
+const CUDD_TOO_MANY_NODES = 2
+
+const CUDD_HANDLE = Ref{Ptr{Cvoid}}(C_NULL)
+
+"""
+    cudd_library()
+
+Path of the shared CUDD library: `ENV["ADD_CUDD_LIB"]` if set, otherwise
+the one `make` builds in `benchmark/cudd_comparison`.
+"""
+cudd_library() = get(ENV, "ADD_CUDD_LIB",
+                     joinpath(dirname(@__DIR__), "benchmark", "cudd_comparison", "cudd", "cudd",
+                              ".libs", "libcudd." * Libdl.dlext))
+
+function cudd_handle()
+    if CUDD_HANDLE[] == C_NULL
+        path = cudd_library()
+        handle = Libdl.dlopen_e(path)
+        handle == C_NULL &&
+            error("cannot load the CUDD library from $path; build it with `make` in " *
+                  "benchmark/cudd_comparison or set ADD_CUDD_LIB")
+        CUDD_HANDLE[] = handle
+    end
+    return CUDD_HANDLE[]
+end
+
+"""
+    cudd_available()
+
+Whether the shared CUDD library (see [`CuddManager`](@ref)) can be loaded.
+"""
+function cudd_available()
+    try
+        cudd_handle()
+        return true
+    catch
+        return false
+    end
+end
+
+@inline function cudd_symbol(cache::Ref{Ptr{Cvoid}}, name::Symbol)
+    p = cache[]
+    if p == C_NULL
+        p = cache[] = Libdl.dlsym(cudd_handle(), name)
+    end
+    return p
+end
+
+# Address of a CUDD function, looked up once per call site
+macro cudd_fn(name)
+    return :(cudd_symbol($(Ref{Ptr{Cvoid}}(C_NULL)), $(esc(name))))
+end
+
+# ccall of a CUDD function: @cudd :Cudd_bddAnd Ptr{Cvoid} (Ptr{Cvoid}, Ptr{Cvoid}, Ptr{Cvoid}) p f g
+macro cudd(name, rettype, argtypes, args...)
+    return Expr(:call, :ccall, :(@cudd_fn($name)), esc(rettype), esc(argtypes), map(esc, args)...)
+end
+
+"""
+    CuddManager(num_vars::Int; unique_slots::Int = 256, cache_slots::Int = 262144,
+                max_memory::Int = 0)
+
+A manager of the CUDD library with `num_vars` BDD/ADD variables and as many
+ZDD variables, run through the same functions as a [`DDManager`](@ref), so
+the same code can be A/B tested on both or fall back to CUDD's reordering
+methods. The keyword arguments go to `Cudd_Init`. The library is found by
+[`cudd_library`](@ref); [`cudd_available`](@ref) checks for it.
+
+Node ids are CUDD's node pointers and have the same conventions as in a
+`DDManager`: `mgr.one`, `mgr.zero` and `mgr.add_zero` are the terminals,
+variables are numbered from 1, and results are not referenced. CUDD's
+automatic garbage collection is switched off, so, as in a `DDManager`,
+unreferenced nodes live until [`garbage_collect!`](@ref) or
+[`reduce_heap!`](@ref). Automatic reordering (see
+[`enable_reordering!`](@ref)) runs inside the operations and collects
+garbage first, so reference every diagram you hold while it is on.
+
+Supported: the BDD operations from `ith_var` to `bdd_squeeze` except
+`bdd_from_cubes`, `bdd_from_truth_table` and the iterators; `add_const`, `add_ith_var`,
+the arithmetic, `add_apply` with `+ - * / max min`, `add_threshold`,
+`add_restrict`, `add_eval`, `add_find_max`, `add_find_min`,
+`add_exist_abstract`, `add_univ_abstract`, `add_matrix_multiply` and
+`add_permute`; the ZDD operations up to `zdd_count` plus `zdd_from_sets`;
+`count_nodes`, `count_paths`, `count_minterms`, `garbage_collect!`,
+`reduce_heap!` (also with CUDD's `:sift_converge`, `:symm_sift`,
+`:window4`, `:group_sift`, `:annealing`, `:genetic`, `:linear` and `:exact`),
+`enable_reordering!`, `disable_reordering!`, `set_node_limit!`,
+`memory_in_use`, `gc_stats` and `cache_stats`. Counts are `Float64`, as
+CUDD computes them. The `AlgebraicDecisionDiagrams.ref!` and `deref!`
+functions map to `Cudd_Ref` and `Cudd_RecursiveDeref(Zdd)`.
+
+The manager is freed by a finalizer or by `close(mgr)`, after which its
+node ids are invalid.
+"""
+mutable struct CuddManager
+    ptr::Ptr{Cvoid}
+    num_vars::Int
+    one::NodeId
+    zero::NodeId
+    add_zero::NodeId
+    gc_reclaimed::Int
+end
+
+function CuddManager(num_vars::Int; unique_slots::Int = 256, cache_slots::Int = 262144,
+                     max_memory::Int = 0)
+    num_vars >= 0 || throw(ArgumentError("the number of variables must be non-negative"))
+    p = @cudd(:Cudd_Init, Ptr{Cvoid}, (Cuint, Cuint, Cuint, Cuint, Csize_t),
+              num_vars, num_vars, unique_slots, cache_slots, max_memory)
+    p == C_NULL && throw(OutOfMemoryError())
+    @cudd(:Cudd_DisableGarbageCollection, Cvoid, (Ptr{Cvoid},), p)
+    one = NodeId(UInt(@cudd(:Cudd_ReadOne, Ptr{Cvoid}, (Ptr{Cvoid},), p)))
+    add_zero = NodeId(UInt(@cudd(:Cudd_ReadZero, Ptr{Cvoid}, (Ptr{Cvoid},), p)))
+    mgr = CuddManager(p, num_vars, one, complement(one), add_zero, 0)
+    return finalizer(close, mgr)
+end
+
+function Base.close(mgr::CuddManager)
+    if mgr.ptr != C_NULL
+        @cudd(:Cudd_Quit, Cvoid, (Ptr{Cvoid},), mgr.ptr)
+        mgr.ptr = C_NULL
+    end
+    return nothing
+end
+
+Base.show(io::IO, mgr::CuddManager) =
+    print(io, "CuddManager(", mgr.num_vars, " variables", mgr.ptr == C_NULL ? ", closed)" : ")")
+
+@inline cudd_ptr(f::NodeId) = Ptr{Cvoid}(UInt(f & ~CUDD_ZDD_TAG))
+
+function cudd_failed(mgr::CuddManager)
+    mgr.ptr == C_NULL && throw(ArgumentError("the CUDD manager is closed"))
+    code = @cudd(:Cudd_ReadErrorCode, Cint, (Ptr{Cvoid},), mgr.ptr)
+    @cudd(:Cudd_ClearErrorCode, Cvoid, (Ptr{Cvoid},), mgr.ptr)
+    code == CUDD_MEMORY_OUT && throw(OutOfMemoryError())
+    code == CUDD_TOO_MANY_NODES &&
+        throw(NodeLimitExceeded(Int(@cudd(:Cudd_ReadMaxLive, Cuint, (Ptr{Cvoid},), mgr.ptr))))
+    error("CUDD operation failed with error code $code")
+end
+
+# Node id of a BDD/ADD or ZDD result, NULL meaning failure
+@inline cudd_bdd(mgr::CuddManager, p::Ptr{Cvoid}) = p == C_NULL ? cudd_failed(mgr) : NodeId(UInt(p))
+@inline cudd_zdd(mgr::CuddManager, p::Ptr{Cvoid}) = cudd_bdd(mgr, p) | CUDD_ZDD_TAG
+
+const DdPtr = Ptr{Cvoid}
+
+function cudd_var(mgr::CuddManager, i::Int)
+    1 <= i <= mgr.num_vars || throw(ArgumentError("variable $i is out of range 1:$(mgr.num_vars)"))
+    return Cint(i - 1)
+end
+
+function cudd_permutation(mgr::CuddManager, permut::AbstractVector{<:Integer})
+    check_permutation(mgr, permut)
+    return Cint[p - 1 for p in permut]
+end
+
+# Run `body(f)` with `f` referenced. The wrappers pass the temporaries
+# they make (cubes, constants) through this, since automatic reordering
+# collects garbage in the middle of an operation.
+function cudd_with_ref(body::F, mgr::CuddManager, f::NodeId) where {F}
+    ref!(mgr, f)
+    try
+        return body(f)
+    finally
+        deref!(mgr, f)
+    end
+end
+
+# BDD operations
+
+ith_var(mgr::CuddManager, i::Int) =
+    cudd_bdd(mgr, @cudd(:Cudd_bddIthVar, DdPtr, (DdPtr, Cint), mgr.ptr, cudd_var(mgr, i)))
+
+bdd_not(::CuddManager, f::NodeId) = complement(f)
+
+bdd_ite(mgr::CuddManager, f::NodeId, g::NodeId, h::NodeId) =
+    cudd_bdd(mgr, @cudd(:Cudd_bddIte, DdPtr, (DdPtr, DdPtr, DdPtr, DdPtr),
+                        mgr.ptr, cudd_ptr(f), cudd_ptr(g), cudd_ptr(h)))
+
+for (op, cudd) in ((:bdd_and, :Cudd_bddAnd), (:bdd_or, :Cudd_bddOr), (:bdd_xor, :Cudd_bddXor),
+                   (:bdd_constrain, :Cudd_bddConstrain), (:bdd_restrict, :Cudd_bddRestrict),
+                   (:bdd_li_compaction, :Cudd_bddLICompaction), (:bdd_squeeze, :Cudd_bddSqueeze),
+                   (:bdd_exists, :Cudd_bddExistAbstract), (:bdd_forall, :Cudd_bddUnivAbstract))
+    @eval $op(mgr::CuddManager, f::NodeId, g::NodeId) =
+        cudd_bdd(mgr, @cudd($(QuoteNode(cudd)), DdPtr, (DdPtr, DdPtr, DdPtr),
+                            mgr.ptr, cudd_ptr(f), cudd_ptr(g)))
+end
+
+# Cofactor by the literal of `var`; works for BDDs and ADDs alike
+function cudd_cofactor(mgr::CuddManager, f::NodeId, var::Int, value::Bool)
+    lit = ith_var(mgr, var)
+    return cudd_bdd(mgr, @cudd(:Cudd_Cofactor, DdPtr, (DdPtr, DdPtr, DdPtr),
+                               mgr.ptr, cudd_ptr(f), cudd_ptr(value ? lit : complement(lit))))
+end
+
+bdd_restrict(mgr::CuddManager, f::NodeId, var::Int, value::Bool) = cudd_cofactor(mgr, f, var, value)
+
+function bdd_cube(mgr::CuddManager, vars::Vector{Int})
+    indices = Cint[cudd_var(mgr, v) for v in vars]
+    return cudd_bdd(mgr, @cudd(:Cudd_IndicesToCube, DdPtr, (DdPtr, Ptr{Cint}, Cint),
+                               mgr.ptr, indices, length(indices)))
+end
+
+bdd_exists(mgr::CuddManager, f::NodeId, vars::Vector{Int}) =
+    cudd_with_ref(cube -> bdd_exists(mgr, f, cube), mgr, bdd_cube(mgr, vars))
+bdd_forall(mgr::CuddManager, f::NodeId, vars::Vector{Int}) =
+    cudd_with_ref(cube -> bdd_forall(mgr, f, cube), mgr, bdd_cube(mgr, vars))
+
+bdd_and_exists(mgr::CuddManager, f::NodeId, g::NodeId, cube::NodeId) =
+    cudd_bdd(mgr, @cudd(:Cudd_bddAndAbstract, DdPtr, (DdPtr, DdPtr, DdPtr, DdPtr),
+                        mgr.ptr, cudd_ptr(f), cudd_ptr(g), cudd_ptr(cube)))
+
+bdd_and_exists(mgr::CuddManager, f::NodeId, g::NodeId, vars::Vector{Int}) =
+    cudd_with_ref(cube -> bdd_and_exists(mgr, f, g, cube), mgr, bdd_cube(mgr, vars))
+
+function bdd_vector_compose(mgr::CuddManager, f::NodeId, vector::AbstractVector{NodeId})
+    length(vector) == mgr.num_vars ||
+        throw(ArgumentError("the vector has $(length(vector)) functions for $(mgr.num_vars) variables"))
+    ptrs = DdPtr[cudd_ptr(g) for g in vector]
+    return cudd_bdd(mgr, @cudd(:Cudd_bddVectorCompose, DdPtr, (DdPtr, DdPtr, Ptr{DdPtr}),
+                               mgr.ptr, cudd_ptr(f), ptrs))
+end
+
+bdd_permute(mgr::CuddManager, f::NodeId, permut::AbstractVector{<:Integer}) =
+    cudd_bdd(mgr, @cudd(:Cudd_bddPermute, DdPtr, (DdPtr, DdPtr, Ptr{Cint}),
+                        mgr.ptr, cudd_ptr(f), cudd_permutation(mgr, permut)))
+
+# ADD operations
+
+add_const(mgr::CuddManager, value::Real) =
+    cudd_bdd(mgr, @cudd(:Cudd_addConst, DdPtr, (DdPtr, Cdouble), mgr.ptr, Float64(value)))
+
+add_ith_var(mgr::CuddManager, i::Int) =
+    cudd_bdd(mgr, @cudd(:Cudd_addIthVar, DdPtr, (DdPtr, Cint), mgr.ptr, cudd_var(mgr, i)))
+
+# Binary operators of Cudd_addApply for the operations add_apply can run
+const CUDD_ADD_OPS = Dict{Any,Symbol}(+ => :Cudd_addPlus, - => :Cudd_addMinus, * => :Cudd_addTimes,
+                                      / => :Cudd_addDivide, max => :Cudd_addMaximum,
+                                      min => :Cudd_addMinimum)
+const CUDD_ADD_OP_PTRS = Dict{Symbol,Ptr{Cvoid}}()
+
+function add_apply(mgr::CuddManager, op, f::NodeId, g::NodeId)
+    name = get(CUDD_ADD_OPS, op, nothing)
+    name === nothing && throw(ArgumentError("CUDD has no ADD operator for $op"))
+    fn = get!(() -> Libdl.dlsym(cudd_handle(), name), CUDD_ADD_OP_PTRS, name)
+    return cudd_bdd(mgr, @cudd(:Cudd_addApply, DdPtr, (DdPtr, Ptr{Cvoid}, DdPtr, DdPtr),
+                               mgr.ptr, fn, cudd_ptr(f), cudd_ptr(g)))
+end
+
+add_plus(mgr::CuddManager, f::NodeId, g::NodeId) = add_apply(mgr, +, f, g)
+add_minus(mgr::CuddManager, f::NodeId, g::NodeId) = add_apply(mgr, -, f, g)
+add_times(mgr::CuddManager, f::NodeId, g::NodeId) = add_apply(mgr, *, f, g)
+add_divide(mgr::CuddManager, f::NodeId, g::NodeId) = add_apply(mgr, /, f, g)
+add_max(mgr::CuddManager, f::NodeId, g::NodeId) = add_apply(mgr, max, f, g)
+add_min(mgr::CuddManager, f::NodeId, g::NodeId) = add_apply(mgr, min, f, g)
+
+add_scalar_multiply(mgr::CuddManager, f::NodeId, scalar::Real) =
+    cudd_with_ref(c -> add_times(mgr, f, c), mgr, add_const(mgr, scalar))
+
+add_negate(mgr::CuddManager, f::NodeId) =
+    cudd_bdd(mgr, @cudd(:Cudd_addNegate, DdPtr, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f)))
+
+add_threshold(mgr::CuddManager, f::NodeId, threshold::Real) =
+    cudd_bdd(mgr, @cudd(:Cudd_addBddThreshold, DdPtr, (DdPtr, DdPtr, Cdouble),
+                        mgr.ptr, cudd_ptr(f), Float64(threshold)))
+
+add_restrict(mgr::CuddManager, f::NodeId, var::Int, value::Bool) = cudd_cofactor(mgr, f, var, value)
+
+cudd_value(f::NodeId) = @cudd(:Cudd_V, Cdouble, (DdPtr,), cudd_ptr(f))
+
+function add_eval(mgr::CuddManager, f::NodeId, assignment::Dict{Int,Bool})
+    inputs = Cint[get(assignment, v, false) for v in 1:mgr.num_vars]
+    leaf = cudd_bdd(mgr, @cudd(:Cudd_Eval, DdPtr, (DdPtr, DdPtr, Ptr{Cint}),
+                               mgr.ptr, cudd_ptr(f), inputs))
+    return cudd_value(leaf)
+end
+
+add_find_max(mgr::CuddManager, f::NodeId) =
+    cudd_value(cudd_bdd(mgr, @cudd(:Cudd_addFindMax, DdPtr, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f))))
+add_find_min(mgr::CuddManager, f::NodeId) =
+    cudd_value(cudd_bdd(mgr, @cudd(:Cudd_addFindMin, DdPtr, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f))))
+
+bdd_to_add(mgr::CuddManager, f::NodeId) =
+    cudd_bdd(mgr, @cudd(:Cudd_BddToAdd, DdPtr, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f)))
+
+# The cube is a BDD, as for a DDManager; CUDD wants it as a 0-1 ADD
+for (op, cudd) in ((:add_exist_abstract, :Cudd_addExistAbstract),
+                   (:add_univ_abstract, :Cudd_addUnivAbstract))
+    @eval begin
+        $op(mgr::CuddManager, f::NodeId, cube::NodeId) =
+            cudd_with_ref(mgr, bdd_to_add(mgr, cube)) do add_cube
+                cudd_bdd(mgr, @cudd($(QuoteNode(cudd)), DdPtr, (DdPtr, DdPtr, DdPtr),
+                                    mgr.ptr, cudd_ptr(f), cudd_ptr(add_cube)))
+            end
+        $op(mgr::CuddManager, f::NodeId, vars::Vector{Int}) =
+            isempty(vars) ? f : cudd_with_ref(cube -> $op(mgr, f, cube), mgr, bdd_cube(mgr, vars))
+    end
+end
+
+# Variables of a BDD cube, top to bottom
+function cudd_cube_vars(mgr::CuddManager, cube::NodeId)
+    vars = Int[]
+    f = cudd_ptr(cube)
+    while @cudd(:Cudd_IsConstant, Cint, (DdPtr,), f) == 0
+        is_complemented(NodeId(UInt(f))) &&
+            throw(ArgumentError("not a cube of positive literals"))
+        push!(vars, Int(@cudd(:Cudd_NodeReadIndex, Cuint, (DdPtr,), f)) + 1)
+        f = @cudd(:Cudd_T, DdPtr, (DdPtr,), f)
+    end
+    return vars
+end
+
+add_matrix_multiply(mgr::CuddManager, A::NodeId, B::NodeId, z::NodeId) =
+    add_matrix_multiply(mgr, A, B, cudd_cube_vars(mgr, z))
+
+function add_matrix_multiply(mgr::CuddManager, A::NodeId, B::NodeId, z::Vector{Int})
+    # Each z variable is made and referenced before the next one, whose
+    # creation could reorder
+    zvars = NodeId[]
+    try
+        for v in z
+            x = add_ith_var(mgr, v)
+            ref!(mgr, x)
+            push!(zvars, x)
+        end
+        ptrs = DdPtr[cudd_ptr(x) for x in zvars]
+        return cudd_bdd(mgr, @cudd(:Cudd_addMatrixMultiply, DdPtr,
+                                   (DdPtr, DdPtr, DdPtr, Ptr{DdPtr}, Cint),
+                                   mgr.ptr, cudd_ptr(A), cudd_ptr(B), ptrs, length(ptrs)))
+    finally
+        foreach(x -> deref!(mgr, x), zvars)
+    end
+end
+
+add_permute(mgr::CuddManager, f::NodeId, permut::AbstractVector{<:Integer}) =
+    cudd_bdd(mgr, @cudd(:Cudd_addPermute, DdPtr, (DdPtr, DdPtr, Ptr{Cint}),
+                        mgr.ptr, cudd_ptr(f), cudd_permutation(mgr, permut)))
+
+# ZDD operations
+
+zdd_empty(mgr::CuddManager) = mgr.add_zero | CUDD_ZDD_TAG
+
+# Cudd_ReadZddOne is the family of all subsets; the base {∅} is the one terminal
+zdd_base(mgr::CuddManager) = mgr.one | CUDD_ZDD_TAG
+
+zdd_singleton(mgr::CuddManager, var::Int) = zdd_change(mgr, zdd_base(mgr), var)
+
+for (op, cudd) in ((:zdd_union, :Cudd_zddUnion), (:zdd_intersection, :Cudd_zddIntersect),
+                   (:zdd_difference, :Cudd_zddDiff))
+    @eval $op(mgr::CuddManager, f::NodeId, g::NodeId) =
+        cudd_zdd(mgr, @cudd($(QuoteNode(cudd)), DdPtr, (DdPtr, DdPtr, DdPtr),
+                            mgr.ptr, cudd_ptr(f), cudd_ptr(g)))
+end
+
+for (op, cudd) in ((:zdd_subset0, :Cudd_zddSubset0), (:zdd_subset1, :Cudd_zddSubset1),
+                   (:zdd_change, :Cudd_zddChange))
+    @eval $op(mgr::CuddManager, f::NodeId, var::Int) =
+        cudd_zdd(mgr, @cudd($(QuoteNode(cudd)), DdPtr, (DdPtr, DdPtr, Cint),
+                            mgr.ptr, cudd_ptr(f), cudd_var(mgr, var)))
+end
+
+zdd_count(mgr::CuddManager, f::NodeId) =
+    @cudd(:Cudd_zddCountDouble, Cdouble, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f))
+
+# CUDD has no bulk constructor: each set is built bottom variable first,
+# then united in
+function zdd_from_sets(mgr::CuddManager, sets::AbstractVector{<:AbstractVector{<:Integer}};
+                       parallel::Bool = false)
+    family = zdd_empty(mgr)
+    for set in sets
+        s = zdd_base(mgr)
+        for v in sort!(unique(Int.(set)); rev = true)
+            s = zdd_change(mgr, s, v)
+        end
+        family = zdd_union(mgr, family, s)
+    end
+    return family
+end
+
+# Counting
+
+function count_nodes(mgr::CuddManager, roots::AbstractVector{NodeId})
+    visited = Set{UInt}()
+    stack = DdPtr[cudd_ptr(f) for f in roots]
+    n = 0
+    while !isempty(stack)
+        f = Ptr{Cvoid}(UInt(pop!(stack)) & ~UInt(1))
+        UInt(f) in visited && continue
+        push!(visited, UInt(f))
+        @cudd(:Cudd_IsConstant, Cint, (DdPtr,), f) == 0 || continue
+        n += 1
+        push!(stack, @cudd(:Cudd_T, DdPtr, (DdPtr,), f), @cudd(:Cudd_E, DdPtr, (DdPtr,), f))
+    end
+    return n
+end
+
+count_nodes(mgr::CuddManager, f::NodeId) = count_nodes(mgr, [f])
+
+count_paths(mgr::CuddManager, f::NodeId) =
+    @cudd(:Cudd_CountPath, Cdouble, (DdPtr,), cudd_ptr(f))
+
+count_minterms(mgr::CuddManager, f::NodeId, nvars::Int) =
+    @cudd(:Cudd_CountMinterm, Cdouble, (DdPtr, DdPtr, Cint), mgr.ptr, cudd_ptr(f), nvars)
+
+# Reference counting, garbage collection and reordering
+
+ref!(::CuddManager, f::NodeId) = @cudd(:Cudd_Ref, Cvoid, (DdPtr,), cudd_ptr(f))
+
+function deref!(mgr::CuddManager, f::NodeId)
+    if f & CUDD_ZDD_TAG != 0
+        @cudd(:Cudd_RecursiveDerefZdd, Cvoid, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f))
+    else
+        @cudd(:Cudd_RecursiveDeref, Cvoid, (DdPtr, DdPtr), mgr.ptr, cudd_ptr(f))
+    end
+end
+
+function garbage_collect!(mgr::CuddManager)
+    # Internal, but the only way to collect while automatic collection is off
+    mgr.gc_reclaimed += @cudd(:cuddGarbageCollect, Cint, (DdPtr, Cint), mgr.ptr, 1)
+    return mgr
+end
+
+function cudd_reorder_method(method::Symbol)
+    haskey(CUDD_REORDER_METHODS, method) ||
+        throw(ArgumentError("unknown reordering method :$method; use one of " *
+                            join(sort!(collect(keys(CUDD_REORDER_METHODS))), ", ")))
+    return Cint(CUDD_REORDER_METHODS[method])
+end
+
+function reduce_heap!(mgr::CuddManager, method::Symbol = :sift)
+    @cudd(:Cudd_ReduceHeap, Cint, (DdPtr, Cint, Cint), mgr.ptr, cudd_reorder_method(method), 0) == 1 ||
+        cudd_failed(mgr)
+    return mgr
+end
+
+function enable_reordering!(mgr::CuddManager; method::Symbol = :sift, threshold::Int = 4096)
+    @cudd(:Cudd_AutodynEnable, Cvoid, (DdPtr, Cint), mgr.ptr, cudd_reorder_method(method))
+    @cudd(:Cudd_SetNextReordering, Cvoid, (DdPtr, Cuint), mgr.ptr, threshold)
+    return mgr
+end
+
+function disable_reordering!(mgr::CuddManager)
+    @cudd(:Cudd_AutodynDisable, Cvoid, (DdPtr,), mgr.ptr)
+    return mgr
+end
+
+function set_node_limit!(mgr::CuddManager, max_nodes::Int = typemax(Int))
+    max_nodes > 0 || throw(ArgumentError("the node limit must be positive"))
+    @cudd(:Cudd_SetMaxLive, Cvoid, (DdPtr, Cuint), mgr.ptr, min(max_nodes, typemax(Cuint)))
+    return mgr
+end
+
+# Statistics
+
+memory_in_use(mgr::CuddManager) = Int(@cudd(:Cudd_ReadMemoryInUse, Csize_t, (DdPtr,), mgr.ptr))
+
+# Only collections by garbage_collect! count towards `reclaimed`
+function gc_stats(mgr::CuddManager)
+    runs = @cudd(:Cudd_ReadGarbageCollections, Cint, (DdPtr,), mgr.ptr)
+    ms = @cudd(:Cudd_ReadGarbageCollectionTime, Clong, (DdPtr,), mgr.ptr)
+    peak = @cudd(:Cudd_ReadPeakNodeCount, Clong, (DdPtr,), mgr.ptr)
+    return (runs = Int(runs), time = ms / 1000, reclaimed = mgr.gc_reclaimed, peak_nodes = Int(peak))
+end
+
+# CUDD counts lookups and hits over all operations together
+function cache_stats(mgr::CuddManager)
+    lookups = round(Int, @cudd(:Cudd_ReadCacheLookUps, Cdouble, (DdPtr,), mgr.ptr))
+    hits = round(Int, @cudd(:Cudd_ReadCacheHits, Cdouble, (DdPtr,), mgr.ptr))
+    return [(op = "all", lookups = lookups, hits = hits, misses = lookups - hits, evictions = 0)]
+end
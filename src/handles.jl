@@ -0,0 +1,143 @@
+# Reference-counted handles and garbage collection at safe points
+
+"""
+    DDHandle{T}
+    DDHandle(mgr::DDManager, id::NodeId)
+
+A diagram of `mgr` that keeps itself referenced: the constructor calls
+`ref!` on `id`, and [`release!`](@ref), or the finalizer once the handle is
+unreachable, gives the reference back. The node id is `h.id`.
+
+The diagram operations also take handles in place of the manager and the
+first operand, and return handles: `bdd_and(f, g)` for two handles is
+`bdd_and(mgr, f.id, g.id)` with the result referenced. Each such call
+starts at a safe point (see [`safe_point!`](@ref)), where the manager
+collects garbage once enough of it has built up, so a program that keeps
+its diagrams in handles runs in bounded memory without calling `ref!`,
+`deref!` or `garbage_collect!`.
+
+A safe point collects every node that is not referenced, so a raw
+`NodeId` kept across handle operations must be referenced by hand. Use
+the handles of a manager from one task at a time, like the manager
+itself; finalizers, which may run at any point, only queue their node for
+the next safe point.
+"""
+mutable struct DDHandle{T<:Real}
+    mgr::DDManager{T}
+    id::NodeId
+
+    function DDHandle{T}(mgr::DDManager{T}, id::NodeId) where {T}
+        ref!(mgr, id)
+        return finalizer(release_later!, new{T}(mgr, id))
+    end
+end
+
+DDHandle(mgr::DDManager{T}, id::NodeId) where {T} = DDHandle{T}(mgr, id)
+
+Base.:(==)(f::DDHandle, g::DDHandle) = f.mgr === g.mgr && f.id == g.id
+Base.hash(f::DDHandle, h::UInt) = hash(f.id, hash(objectid(f.mgr), h))
+
+function Base.show(io::IO, f::DDHandle)
+    f.id == INVALID_NODE ? print(io, "DDHandle(released)") :
+                           print(io, "DDHandle(0x", string(f.id; base = 16), ")")
+end
+
+"""
+    release!(f::DDHandle)
+
+Give back the reference of `f` now rather than when it is finalized. The
+handle cannot be used afterwards; releasing it again does nothing.
+"""
+function release!(f::DDHandle)
+    if f.id != INVALID_NODE
+        deref!(f.mgr, f.id)
+        f.id = INVALID_NODE
+    end
+    return nothing
+end
+
+# Finalizer. It may interrupt an operation on the manager, so the node is only
+# queued; when the queue is taken (by the task being interrupted, or another
+# thread), the handle waits for a later collection.
+function release_later!(f::DDHandle)
+    f.id == INVALID_NODE && return nothing
+    mgr = f.mgr
+    if !trylock(mgr.release_lock)
+        finalizer(release_later!, f)
+        return nothing
+    end
+    try
+        push!(mgr.released, f.id)
+    finally
+        unlock(mgr.release_lock)
+    end
+    f.id = INVALID_NODE
+    return nothing
+end
+
+# Smallest amount of possible garbage worth a pass over the node store
+const SAFE_POINT_MIN_GARBAGE = 1024
+
+"""
+    safe_point!(mgr::DDManager)
+
+Tidy up `mgr` between two top-level operations, where only referenced
+nodes are in use. The nodes of finalized handles are dereferenced; then,
+if the dead roots plus the nodes created since the last collection are
+more than `gc_frac` (0.2) of the store, garbage is collected, and a
+pending automatic reordering is run.
+
+Counting every new node as possible garbage errs towards collecting: when
+all of them are live, the store has still grown by a fixed factor since
+the last collection, so the collections cost a constant amount per node.
+The handle operations call this on entry; call it yourself between
+operations on raw ids only if every diagram you keep is referenced.
+"""
+function safe_point!(mgr::DDManager)
+    if !isempty(mgr.released)
+        lock(mgr.release_lock)
+        released = mgr.released
+        mgr.released = NodeId[]
+        unlock(mgr.release_lock)
+        foreach(id -> deref!(mgr, id), released)
+    end
+    garbage = mgr.num_dead + max(mgr.num_nodes - mgr.gc_live, 0)
+    if garbage >= SAFE_POINT_MIN_GARBAGE && garbage > mgr.gc_frac * mgr.num_nodes
+        garbage_collect!(mgr)
+    end
+    mgr.has_zdd || check_reorder(mgr)
+    return mgr
+end
+
+unwrap(::DDManager, x) = x
+
+function unwrap(mgr::DDManager, f::DDHandle)
+    f.mgr === mgr || throw(ArgumentError("the handles belong to different managers"))
+    f.id == INVALID_NODE && throw(ArgumentError("the handle has been released"))
+    return f.id
+end
+
+# Run `op(mgr, ...)` on the ids of the handles after a safe point, keeping a
+# diagram result in a new handle before anything can collect it
+function handle_op(op::F, f::DDHandle, args...) where {F}
+    mgr = f.mgr
+    safe_point!(mgr)
+    result = op(mgr, unwrap(mgr, f), map(x -> unwrap(mgr, x), args)...)
+    return result isa NodeId ? DDHandle(mgr, result) : result
+end
+
+for op in (:bdd_and, :bdd_or, :bdd_xor, :bdd_not, :bdd_ite, :bdd_restrict, :bdd_exists,
+           :bdd_forall, :bdd_and_exists, :bdd_permute, :bdd_constrain, :bdd_li_compaction,
+           :bdd_squeeze,
+           :add_plus, :add_minus, :add_times, :add_divide, :add_max, :add_min, :add_negate,
+           :add_scalar_multiply, :add_threshold, :add_restrict, :add_eval, :compile_add,
+           :add_find_max, :add_find_min, :add_exist_abstract, :add_univ_abstract,
+           :add_max_abstract, :add_min_abstract, :add_matrix_multiply, :add_permute,
+           :zdd_union, :zdd_intersection, :zdd_difference, :zdd_subset0, :zdd_subset1,
+           :zdd_change, :zdd_count, :zdd_log_count, :zdd_to_sets,
+           :count_nodes, :count_paths, :count_minterms, :log_count_minterms)
+    @eval $op(f::DDHandle, args...) = handle_op($op, f, args...)
+end
+
+add_apply(op::F, f::DDHandle, g::DDHandle) where {F} =
+    handle_op((mgr, a, b) -> add_apply(mgr, op, a, b), f, g)
@@ -0,0 +1,231 @@
+# Lazy iteration over ZDD sets and BDD cubes/minterms
+#
+# All iterators walk the diagram depth-first with an explicit stack and
+# yield one reused buffer: copy an element to keep it past the next step.
+# Branches to the empty terminal are never pushed, and in a reduced diagram
+# every other node leads to at least one element, so each element costs at
+# most one root-to-terminal walk.
+
+"""
+    ZddSetIterator
+
+Iterator over the sets of a ZDD, returned by [`zdd_sets`](@ref).
+"""
+struct ZddSetIterator{M<:DDManager}
+    mgr::M
+    root::NodeId
+end
+
+# Work item: continue from `id` once the set is cut back to `len`
+# elements, after appending `var` (unless 0)
+struct SetFrame
+    id::NodeId
+    len::Int
+    var::Int
+end
+
+struct SetWalk
+    frames::Vector{SetFrame}
+    set::Vector{Int}
+end
+
+"""
+    zdd_sets(mgr::DDManager, f::NodeId)
+
+Lazily iterate over the sets of the ZDD `f`, in the order of
+[`zdd_to_sets`](@ref), using memory proportional to the number of variables.
+Each set is yielded as the same `Vector{Int}` buffer, overwritten by the next
+step, so `copy` a set to keep it. Works with `Iterators.take` and friends:
+
+```julia
+for s in Iterators.take(zdd_sets(mgr, family), 10)
+    println(s)
+end
+```
+"""
+zdd_sets(mgr::DDManager, f::NodeId) = ZddSetIterator(mgr, f)
+
+Base.IteratorSize(::Type{<:ZddSetIterator}) = Base.SizeUnknown()
+Base.eltype(::Type{<:ZddSetIterator}) = Vector{Int}
+
+function Base.iterate(it::ZddSetIterator)
+    walk = SetWalk(SetFrame[], Int[])
+    it.root == zdd_empty(it.mgr) || push!(walk.frames, SetFrame(it.root, 0, 0))
+    return iterate(it, walk)
+end
+
+function Base.iterate(it::ZddSetIterator, walk::SetWalk)
+    mgr = it.mgr
+    store = mgr.nodes
+    set = walk.set
+    @inbounds while !isempty(walk.frames)
+        frame = pop!(walk.frames)
+        resize!(set, frame.len)
+        frame.var != 0 && push!(set, frame.var)
+
+        # Follow the else-chain, leaving the then-branches for later
+        id = frame.id
+        while !is_terminal(mgr, id)
+            idx = node_slot(id)
+            push!(walk.frames, SetFrame(store.then_child[idx], length(set), Int(store.index[idx])))
+            id = store.else_child[idx]
+        end
+        if id == zdd_base(mgr)
+            return set, walk
+        end
+    end
+    return nothing
+end
+
+"""
+    BddCubeIterator
+
+Iterator over the cubes of a BDD, returned by [`bdd_cubes`](@ref).
+"""
+struct BddCubeIterator{M<:DDManager}
+    mgr::M
+    root::NodeId
+end
+
+# Work item: continue from `id` once the path is cut back to `len`
+# variables, after setting `var` (unless 0) to `value`
+struct CubeFrame
+    id::NodeId
+    len::Int
+    var::Int
+    value::Int8
+end
+
+struct CubeWalk
+    frames::Vector{CubeFrame}
+    path::Vector{Int}    # Variables set on the current path
+    cube::Vector{Int8}
+end
+
+"""
+    bdd_cubes(mgr::DDManager, f::NodeId)
+
+Lazily iterate over the paths of the BDD `f` to the one terminal, like CUDD's
+`Cudd_ForeachCube`. Each cube is a `Vector{Int8}` indexed by variable:
+`1` for a positive literal, `0` for a negative one and `2` for a variable
+the path does not test. The cubes are disjoint and together cover exactly
+the satisfying assignments of `f`.
+
+The same buffer is yielded every time and overwritten by the next step, so
+`copy` a cube to keep it.
+"""
+bdd_cubes(mgr::DDManager, f::NodeId) = BddCubeIterator(mgr, f)
+
+Base.IteratorSize(::Type{<:BddCubeIterator}) = Base.SizeUnknown()
+Base.eltype(::Type{<:BddCubeIterator}) = Vector{Int8}
+
+function Base.iterate(it::BddCubeIterator)
+    walk = CubeWalk(CubeFrame[], Int[], fill(Int8(2), it.mgr.num_vars))
+    it.root == it.mgr.zero || push!(walk.frames, CubeFrame(it.root, 0, 0, Int8(0)))
+    return iterate(it, walk)
+end
+
+function Base.iterate(it::BddCubeIterator, walk::CubeWalk)
+    mgr = it.mgr
+    path, cube = walk.path, walk.cube
+    @inbounds while !isempty(walk.frames)
+        frame = pop!(walk.frames)
+        while length(path) > frame.len
+            cube[pop!(path)] = Int8(2)
+        end
+        if frame.var != 0
+            cube[frame.var] = frame.value
+            push!(path, frame.var)
+        end
+
+        # Follow the else-branches, leaving the then-branches for later
+        id = frame.id
+        while !is_terminal(mgr, id)
+            var = Int(node_index(mgr, id))
+            t = then_child(mgr, id)
+            e = else_child(mgr, id)
+            if t != mgr.zero
+                push!(walk.frames, CubeFrame(t, length(path), var, Int8(1)))
+            end
+            e == mgr.zero && break
+            cube[var] = Int8(0)
+            push!(path, var)
+            id = e
+        end
+        if id == mgr.one
+            return cube, walk
+        end
+    end
+    return nothing
+end
+
+"""
+    BddMintermIterator
+
+Iterator over the satisfying assignments of a BDD, returned by
+[`bdd_minterms`](@ref).
+"""
+struct BddMintermIterator{M<:DDManager}
+    cubes::BddCubeIterator{M}
+end
+
+struct MintermWalk
+    cube_walk::CubeWalk
+    free::Vector{Int}           # Variables the current cube leaves open
+    assignment::Vector{Bool}
+end
+
+"""
+    bdd_minterms(mgr::DDManager, f::NodeId)
+
+Lazily iterate over the satisfying assignments of the BDD `f` over all the
+manager's variables: every cube of [`bdd_cubes`](@ref) is expanded over the
+variables it leaves open. Each assignment is a `Vector{Bool}` indexed by
+variable; the same buffer is yielded every time, so `copy` one to keep it.
+There are `count_minterms(mgr, f, mgr.num_vars)` of them.
+"""
+bdd_minterms(mgr::DDManager, f::NodeId) = BddMintermIterator(bdd_cubes(mgr, f))
+
+Base.IteratorSize(::Type{<:BddMintermIterator}) = Base.SizeUnknown()
+Base.eltype(::Type{<:BddMintermIterator}) = Vector{Bool}
+
+# Load a cube into the assignment with all of its open variables false
+function start_cube!(walk::MintermWalk, cube::Vector{Int8})
+    empty!(walk.free)
+    @inbounds for var in eachindex(cube)
+        if cube[var] == 2
+            push!(walk.free, var)
+            walk.assignment[var] = false
+        else
+            walk.assignment[var] = cube[var] == 1
+        end
+    end
+end
+
+function Base.iterate(it::BddMintermIterator)
+    res = iterate(it.cubes)
+    res === nothing && return nothing
+    cube, cube_walk = res
+    walk = MintermWalk(cube_walk, Int[], Vector{Bool}(undef, length(cube)))
+    start_cube!(walk, cube)
+    return walk.assignment, walk
+end
+
+function Base.iterate(it::BddMintermIterator, walk::MintermWalk)
+    # Binary increment over the open variables of the current cube
+    assignment = walk.assignment
+    @inbounds for var in walk.free
+        if assignment[var]
+            assignment[var] = false
+        else
+            assignment[var] = true
+            return assignment, walk
+        end
+    end
+
+    # Exhausted: move to the next cube
+    res = iterate(it.cubes, walk.cube_walk)
+    res === nothing && return nothing
+    start_cube!(walk, res[1])
+    return assignment, walk
+end
@@ -0,0 +1,400 @@
+# Parallel apply operations on threaded managers
+
+"""
+    default_spawn_depth()
+
+Number of recursion levels that fork tasks: enough for every thread to get
+several subproblems to steal.
+"""
+default_spawn_depth() = ceil(Int, log2(Threads.nthreads())) + 2
+
+is_capacity_error(err) = err isa NodeCapacityExceeded ||
+    (err isa TaskFailedException && is_capacity_error(err.task.exception))
+
+# The node limit error a failed task carries, or nothing
+limit_error(err) = err isa NodeLimitExceeded ? err :
+    err isa TaskFailedException ? limit_error(err.task.exception) : nothing
+
+"""
+    reserve_nodes!(mgr::DDManager, capacity::Int)
+
+Reserve room for `capacity` node slots, so appending nodes cannot move the
+store's columns while other tasks read them.
+"""
+function reserve_nodes!(mgr::DDManager, capacity::Int)
+    store = mgr.nodes
+    for column in (store.index, store.ref, store.then_child, store.else_child)
+        sizehint!(column, capacity)
+    end
+    # Every new constant takes a slot, so this bounds the value table's growth
+    sizehint!(mgr.values, length(mgr.values) + length(mgr.free_list) + max(capacity - length(store), 0))
+    mgr.node_capacity = capacity
+    return mgr
+end
+
+"""
+    run_parallel(body, mgr::DDManager)
+
+Run `body()` as a parallel operation: freeze the computed table's size,
+reserve node slots, and rerun with twice the reservation if it ran out.
+Tasks cannot collect garbage under each other, so hitting the node limit
+aborts the operation with [`NodeLimitExceeded`](@ref) straight away.
+"""
+function run_parallel(body::F, mgr::DDManager) where {F}
+    mgr.threaded ||
+        throw(ArgumentError("parallel operations need a manager created with threaded = true"))
+    reserve = max(length(mgr.nodes), 1 << 16)
+    while true
+        reserve_nodes!(mgr, length(mgr.nodes) + reserve)
+        mgr.cache.frozen = true
+        mgr.limit_depth += 1
+        try
+            return body()
+        catch err
+            limit = limit_error(err)
+            limit === nothing || throw(limit)
+            is_capacity_error(err) || rethrow()
+            # Nodes built so far stay in the tables and are reused by the rerun
+            reserve *= 2
+        finally
+            mgr.limit_depth -= 1
+            mgr.cache.frozen = false
+            mgr.node_capacity = typemax(Int)
+        end
+    end
+end
+
+"""
+    fork_join(left, right)
+
+Run `left()` in a new task and `right()` in the current one. The task is
+always waited for, so no work is left running when an error propagates.
+"""
+@inline function fork_join(left::L, right::R) where {L,R}
+    task = Threads.@spawn left()
+    local r
+    try
+        r = right()
+    catch err
+        try
+            wait(task)
+        catch
+        end
+        throw(err)
+    end
+    return fetch(task), r
+end
+
+# Binary BDD operation: fork the cofactor recursions, then finish sequentially
+function parallel_bdd_rec(mgr::DDManager, op::F, tag::UInt64, f::NodeId, g::NodeId,
+                          depth::Int) where {F}
+    if depth <= 0 || is_terminal(mgr, f) || is_terminal(mgr, g) || regular(f) == regular(g)
+        return op(mgr, f, g)
+    end
+
+    # Normalize as the sequential engine does, so both share cache entries:
+    # ensure f <= g for commutativity
+    if f > g
+        f, g = g, f
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, tag, f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return cached
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+    top_level = min(f_level, g_level)
+
+    # Compute cofactors
+    fv, fnv = cofactors(mgr, f, f_level, top_level)
+    gv, gnv = cofactors(mgr, g, g_level, top_level)
+
+    # Recursive calls
+    t, e = fork_join(() -> parallel_bdd_rec(mgr, op, tag, fv, gv, depth - 1),
+                     () -> parallel_bdd_rec(mgr, op, tag, fnv, gnv, depth - 1))
+
+    # Build result
+    var_index = mgr.invperm[top_level]
+    result = unique_lookup(mgr, var_index, t, e)
+
+    # Cache result
+    cache_insert!(mgr, tag, f, g, UInt64(0), result)
+
+    return result
+end
+
+"""
+    parallel_and(mgr::DDManager, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+
+Parallel version of [`bdd_and`](@ref) for managers created with
+`threaded = true`. The top `depth` levels of the recursion fork tasks that
+Julia's scheduler spreads over the threads; below that the sequential
+operation runs, sharing the manager's unique and computed tables.
+No other operation may use the manager while this runs.
+"""
+function parallel_and(mgr::DDManager, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+    return run_parallel(() -> parallel_bdd_rec(mgr, bdd_and, OP_AND, f, g, depth), mgr)
+end
+
+"""
+    parallel_or(mgr::DDManager, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+
+Parallel version of [`bdd_or`](@ref); see [`parallel_and`](@ref).
+"""
+function parallel_or(mgr::DDManager, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+    return run_parallel(() -> parallel_bdd_rec(mgr, bdd_or, OP_OR, f, g, depth), mgr)
+end
+
+"""
+    parallel_xor(mgr::DDManager, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+
+Parallel version of [`bdd_xor`](@ref); see [`parallel_and`](@ref).
+"""
+function parallel_xor(mgr::DDManager, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+    return run_parallel(() -> parallel_bdd_rec(mgr, bdd_xor, OP_XOR, f, g, depth), mgr)
+end
+
+function parallel_ite_rec(mgr::DDManager, f::NodeId, g::NodeId, h::NodeId, depth::Int)
+    if depth <= 0 || is_terminal(mgr, f) || g == h
+        return bdd_ite(mgr, f, g, h)
+    end
+
+    # Normalize as the sequential engine does, so both share cache entries
+    if f == g
+        g = mgr.one
+    elseif f == h
+        h = mgr.zero
+    end
+    if is_complemented(f)
+        f = complement(f)
+        g, h = h, g
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, OP_ITE, f, g, h)
+    if cached != INVALID_NODE
+        return cached
+    end
+
+    # Find top variable
+    f_level = node_level(mgr, f)
+    g_level = node_level(mgr, g)
+    h_level = node_level(mgr, h)
+    top_level = min(f_level, g_level, h_level)
+
+    # Compute cofactors
+    fv, fnv = cofactors(mgr, f, f_level, top_level)
+    gv, gnv = cofactors(mgr, g, g_level, top_level)
+    hv, hnv = cofactors(mgr, h, h_level, top_level)
+
+    # Recursive calls
+    t, e = fork_join(() -> parallel_ite_rec(mgr, fv, gv, hv, depth - 1),
+                     () -> parallel_ite_rec(mgr, fnv, gnv, hnv, depth - 1))
+
+    # Build result
+    var_index = mgr.invperm[top_level]
+    result = unique_lookup(mgr, var_index, t, e)
+
+    # Cache result
+    cache_insert!(mgr, OP_ITE, f, g, h, result)
+
+    return result
+end
+
+"""
+    parallel_ite(mgr::DDManager, f::NodeId, g::NodeId, h::NodeId; depth::Int = default_spawn_depth())
+
+Parallel version of [`bdd_ite`](@ref); see [`parallel_and`](@ref).
+"""
+function parallel_ite(mgr::DDManager, f::NodeId, g::NodeId, h::NodeId;
+                      depth::Int = default_spawn_depth())
+    return run_parallel(() -> parallel_ite_rec(mgr, f, g, h, depth), mgr)
+end
+
+function parallel_add_rec(mgr::DDManager, op::F, op_tag::UInt64, f::NodeId, g::NodeId,
+                          depth::Int) where {F}
+    if depth <= 0 || (is_terminal(mgr, f) && is_terminal(mgr, g))
+        return apply_op(mgr, AddApply(op, op_tag), f, g)
+    end
+
+    # Check cache
+    cached = cache_lookup(mgr, op_tag, f, g, UInt64(0))
+    if cached != INVALID_NODE
+        return cached
+    end
+
+    # Find top variable
+    f_level = add_node_level(mgr, f)
+    g_level = add_node_level(mgr, g)
+    top_level = min(f_level, g_level)
+
+    # Compute cofactors
+    fv, fnv = add_cofactors(mgr, f, f_level, top_level)
+    gv, gnv = add_cofactors(mgr, g, g_level, top_level)
+
+    # Recursive calls
+    t, e = fork_join(() -> parallel_add_rec(mgr, op, op_tag, fv, gv, depth - 1),
+                     () -> parallel_add_rec(mgr, op, op_tag, fnv, gnv, depth - 1))
+
+    # Build result
+    var_index = mgr.invperm[top_level]
+    result = add_unique_lookup(mgr, var_index, t, e)
+
+    # Cache result
+    cache_insert!(mgr, op_tag, f, g, UInt64(0), result)
+
+    return result
+end
+
+"""
+    parallel_add_apply(mgr::DDManager, op, f::NodeId, g::NodeId; depth::Int = default_spawn_depth())
+
+Parallel version of [`add_apply`](@ref); see [`parallel_and`](@ref).
+`op` must be safe to call from several threads at once.
+"""
+function parallel_add_apply(mgr::DDManager, op::F, f::NodeId, g::NodeId;
+                            depth::Int = default_spawn_depth()) where {F}
+    # Resolve the tag up front: the registry is not thread-safe
+    op_tag = add_op_tag(mgr, op)
+    return run_parallel(() -> parallel_add_rec(mgr, op, op_tag, f, g, depth), mgr)
+end
+
+# Sharding across managers
+
+"""
+    transfer(src::DDManager, dst::DDManager, f::NodeId)
+    transfer(src::DDManager, dst::DDManager, roots::AbstractVector{NodeId})
+
+Copy the diagram `f` (BDD, ADD or ZDD) from `src` into `dst`, like CUDD's
+`Cudd_bddTransfer`, and return its id in `dst`. Variables keep their
+indices, so `dst` needs at least as many as the diagram uses.
+
+The nodes are copied level by level from the bottom up, each child looked
+up in an array indexed by source slot, so every node is visited once and
+no cache is involved. Parts already present in `dst` are shared. When
+`dst` orders some variables differently, the nodes that would land above
+their children are moved to their place by an if-then-else on the variable
+(ZDDs need the same order). `src` is only read, so several tasks may
+transfer from it at once; each `dst` must be used by one task at a time
+unless it is threaded.
+
+Given a vector, all roots share one pass and the ids come back in order.
+"""
+function transfer(src::DDManager, dst::DDManager, roots::AbstractVector{NodeId})
+    src === dst && return collect(roots)
+    return with_node_limit(() -> transfer_pass(src, dst, roots), dst, ())
+end
+
+transfer(src::DDManager, dst::DDManager, f::NodeId) = transfer(src, dst, [f])[1]
+
+function transfer_pass(src::DDManager, dst::DDManager, roots::AbstractVector{NodeId})
+    store = src.nodes
+    slots = bottom_up_slots(src, roots)
+    src.has_zdd && (dst.has_zdd = true)
+    # Moving a node down needs to know how to read it: BDDs are the only
+    # diagrams whose inner edges are complemented
+    is_bdd = nothing
+
+    memo = Vector{NodeId}(undef, length(store))
+    @inline edge(id) = is_terminal(src, id) ?
+        (node_slot(id) == node_slot(src.one) ? dst.one ⊻ (id & 0x01) :
+                                               const_lookup(dst, slot_value(src, node_slot(id)))) :
+        @inbounds(memo[node_slot(id)]) ⊻ (id & 0x01)
+
+    @inbounds for idx in slots
+        var = Int(store.index[idx])
+        var <= dst.num_vars ||
+            throw(ArgumentError("variable $var is out of range for a manager with $(dst.num_vars) variables"))
+        t = edge(store.then_child[idx])
+        e = edge(store.else_child[idx])
+        level = dst.perm[var]
+        if node_level(dst, t) > level && node_level(dst, e) > level
+            memo[idx] = find_or_create_node!(dst, var, t, e)
+        else
+            src.has_zdd &&
+                throw(ArgumentError("ZDDs can only be transferred to a manager with the same variable order"))
+            if is_bdd === nothing
+                is_bdd = any(r -> is_complemented(r), roots) ||
+                         any(i -> is_complemented(store.then_child[i]) || is_complemented(store.else_child[i]), slots)
+            end
+            memo[idx] = is_bdd ? bdd_ite(dst, ith_var(dst, var), t, e) : add_var_ite(dst, var, t, e)
+        end
+    end
+    return NodeId[edge(f) for f in roots]
+end
+
+"""
+    parallel_reduce(op, mgr::DDManager, fs::AbstractVector{NodeId};
+                    ntasks::Int = Threads.nthreads())
+
+Combine the diagrams `fs` of `mgr` with the binary operation `op`, such as
+`bdd_and` or `bdd_or`, sharded over `ntasks` tasks that each have a
+private manager, and return the result in `mgr`. `op(m, f, g)` must
+be associative and is called on the private managers, so any operation
+on diagrams works, e.g. `add_plus`. It need not be commutative: the
+operands are combined in the order of `fs`.
+
+Each task transfers a contiguous chunk of `fs` (see [`transfer`](@ref))
+into a fresh manager with the order, `epsilon`, computed-table shape and
+node limit of `mgr`, and folds it pairwise. The partial results are then
+merged pairwise, each merge transferring a shard's result into the
+manager of its left neighbour, and the last is transferred back.
+Unlike [`parallel_and`](@ref), `mgr` need not be threaded, and the
+tasks never contend for one unique table or computed table; the price is
+copying every operand and partial result once.
+"""
+function parallel_reduce(op::F, mgr::DDManager{T}, fs::AbstractVector{NodeId};
+                         ntasks::Int = Threads.nthreads()) where {F,T}
+    isempty(fs) && throw(ArgumentError("parallel_reduce needs at least one diagram"))
+    ntasks >= 1 || throw(ArgumentError("ntasks must be positive"))
+    ntasks = min(ntasks, length(fs))
+    # Contiguous chunks in order, since `op` need not be commutative
+    bounds = [div((k - 1) * length(fs), ntasks) for k in 1:ntasks + 1]
+    chunks = [view(fs, bounds[k] + 1:bounds[k + 1]) for k in 1:ntasks]
+
+    # The operands are transferred while `mgr` is only read
+    shards = Vector{Tuple{DDManager{T},NodeId}}(undef, ntasks)
+    @sync for k in 1:ntasks
+        Threads.@spawn begin
+            local_mgr = shard_manager(mgr)
+            shards[k] = (local_mgr, fold_pairwise(op, local_mgr, transfer(mgr, local_mgr, chunks[k])))
+        end
+    end
+
+    # Merge shard k + step into shard k; merges of one round touch disjoint managers
+    step = 1
+    while step < ntasks
+        @sync for k in 1:(2 * step):(ntasks - step)
+            Threads.@spawn begin
+                dst, f = shards[k]
+                src, g = shards[k + step]
+                shards[k] = (dst, op(dst, f, transfer(src, dst, g)))
+            end
+        end
+        step *= 2
+    end
+    local_mgr, result = shards[1]
+    return transfer(local_mgr, mgr, result)
+end
+
+# A private manager with the order, constant tolerance, cache shape and node
+# limit of `mgr`, so that a shard computes what `mgr` would
+function shard_manager(mgr::DDManager{T}) where {T}
+    cache = mgr.cache
+    shard = DDManager{T}(mgr.num_vars; cache_size = length(cache.entries),
+                         max_cache_size = cache.max_size, cache_ways = cache.ways,
+                         epsilon = mgr.epsilon, max_nodes = mgr.max_nodes)
+    return set_initial_order!(shard, copy(mgr.invperm))
+end
+
+# Balanced fold: combine neighbours until one diagram is left
+function fold_pairwise(op::F, mgr::DDManager, fs::Vector{NodeId}) where {F}
+    while length(fs) > 1
+        fs = NodeId[k < length(fs) ? op(mgr, fs[k], fs[k + 1]) : fs[k] for k in 1:2:length(fs)]
+    end
+    return fs[1]
+end
@@ -0,0 +1,322 @@
+# Dynamic variable reordering (adjacent swaps, sifting, window permutation)
+
+"""
+    table_insert!(mgr::DDManager, table::UniqueTable, node_idx::Int)
+
+Enter an existing node slot into `table`, growing it when too full.
+"""
+@inline function table_insert!(mgr::DDManager, table::UniqueTable, node_idx::Int)
+    store = mgr.nodes
+    h = @inbounds hash_node(store.then_child[node_idx], store.else_child[node_idx])
+    insert_entry!(table, table_entry(fingerprint(h), node_idx))
+    if table_full(table)
+        resize_unique_table!(mgr, table)
+    end
+end
+
+"""
+    table_remove!(mgr::DDManager, table::UniqueTable, node_idx::Int)
+
+Take a node slot out of `table`.
+"""
+function table_remove!(mgr::DDManager, table::UniqueTable, node_idx::Int)
+    store = mgr.nodes
+    h = @inbounds hash_node(store.then_child[node_idx], store.else_child[node_idx])
+    remove_entry!(table, fingerprint(h), node_idx)
+end
+
+"""
+    ReorderState
+
+Scratch state of one reordering run: the number of live parents (plus
+external references and projection roots) of every node slot, and a
+worklist for freeing nodes whose count drops to zero.
+"""
+struct ReorderState
+    refs::Vector{Int}
+    dead::Vector{Int}
+end
+
+function ReorderState(mgr::DDManager)
+    store = mgr.nodes
+    live = mgr.gc_marks  # Left behind by garbage_collect!
+    refs = zeros(Int, length(store))
+    @inbounds for idx in 1:length(store)
+        live[idx] || continue
+        refs[idx] += store.ref[idx]
+        if store.index[idx] != TERMINAL_INDEX
+            refs[node_slot(store.then_child[idx])] += 1
+            refs[node_slot(store.else_child[idx])] += 1
+        end
+    end
+    for v in mgr.vars
+        refs[node_slot(v)] += 1
+    end
+    return ReorderState(refs, Int[])
+end
+
+@inline function inc_ref!(mgr::DDManager, state::ReorderState, id::NodeId)
+    idx = node_slot(id)
+    if idx > length(state.refs)
+        # Slots appended to the store since the counts were taken
+        old = length(state.refs)
+        resize!(state.refs, length(mgr.nodes))
+        state.refs[old+1:end] .= 0
+    end
+    @inbounds state.refs[idx] += 1
+end
+
+@inline function dec_ref!(mgr::DDManager, state::ReorderState, id::NodeId)
+    idx = node_slot(id)
+    @inbounds state.refs[idx] -= 1
+    @inbounds if state.refs[idx] == 0 && mgr.nodes.index[idx] != TERMINAL_INDEX
+        push!(state.dead, idx)
+    end
+end
+
+# Free every node on the dead worklist, cascading into children
+function free_dead!(mgr::DDManager, state::ReorderState)
+    store = mgr.nodes
+    @inbounds while !isempty(state.dead)
+        idx = pop!(state.dead)
+        table_remove!(mgr, mgr.unique_tables[mgr.perm[store.index[idx]]], idx)
+        push!(mgr.free_list, idx)
+        mgr.num_nodes -= 1
+        dec_ref!(mgr, state, store.then_child[idx])
+        dec_ref!(mgr, state, store.else_child[idx])
+    end
+end
+
+"""
+    swap_levels!(mgr::DDManager, state::ReorderState, level::Int)
+
+Exchange the variables at `level` and `level + 1` in place. Every node keeps
+the function it represents, so node ids held by the caller stay valid.
+Returns the number of live nodes afterwards.
+"""
+function swap_levels!(mgr::DDManager, state::ReorderState, level::Int)
+    store = mgr.nodes
+    x = mgr.invperm[level]
+    y = mgr.invperm[level + 1]
+    xtable = mgr.unique_tables[level]
+    ytable = mgr.unique_tables[level + 1]
+
+    # Take the x nodes out; their table moves down with x
+    xs = Int[]
+    @inbounds for entry in xtable.slots
+        entry != 0 && push!(xs, entry_slot(entry))
+    end
+    fill!(xtable.slots, 0)
+    xtable.keys = 0
+
+    mgr.perm[x], mgr.perm[y] = level + 1, level
+    mgr.invperm[level], mgr.invperm[level + 1] = y, x
+    mgr.unique_tables[level], mgr.unique_tables[level + 1] = ytable, xtable
+
+    # x nodes that do not test y just move down a level. They go in first,
+    # so the new x nodes built below share them instead of duplicating them.
+    depends_on_y(id) = @inbounds store.index[node_slot(id)] == y
+    dependent = Int[]
+    @inbounds for idx in xs
+        if depends_on_y(store.then_child[idx]) || depends_on_y(store.else_child[idx])
+            push!(dependent, idx)
+        else
+            table_insert!(mgr, xtable, idx)
+        end
+    end
+
+    # Rewrite F = x ? (y ? F11 : F10) : (y ? F01 : F00)
+    # as        y ? (x ? F11 : F01) : (x ? F10 : F00), keeping F's slot
+    @inbounds for idx in dependent
+        f1 = store.then_child[idx]
+        f0 = store.else_child[idx]
+        f11, f10 = depends_on_y(f1) ? (then_child(mgr, f1), else_child(mgr, f1)) : (f1, f1)
+        f01, f00 = depends_on_y(f0) ? (then_child(mgr, f0), else_child(mgr, f0)) : (f0, f0)
+
+        t = child_node!(mgr, state, x, f11, f01)
+        e = child_node!(mgr, state, x, f10, f00)
+        inc_ref!(mgr, state, t)
+        inc_ref!(mgr, state, e)
+
+        store.index[idx] = UInt32(y)
+        store.then_child[idx] = t
+        store.else_child[idx] = e
+        table_insert!(mgr, ytable, idx)
+
+        dec_ref!(mgr, state, f1)
+        dec_ref!(mgr, state, f0)
+        free_dead!(mgr, state)
+    end
+
+    return mgr.num_nodes
+end
+
+# Find or build an x node during a swap, counting the references it adds
+function child_node!(mgr::DDManager, state::ReorderState, x::Int, t::NodeId, e::NodeId)
+    before = mgr.num_nodes
+    id = unique_lookup(mgr, x, t, e)
+    if mgr.num_nodes != before
+        # Freshly created: it references its children
+        inc_ref!(mgr, state, t)
+        inc_ref!(mgr, state, e)
+    end
+    return id
+end
+
+"""
+    sift_variable!(mgr::DDManager, state::ReorderState, var::Int)
+
+Move `var` through all levels and leave it where the diagram was smallest.
+A direction is abandoned once the size exceeds `mgr.max_growth` times the
+size the sift started from.
+"""
+function sift_variable!(mgr::DDManager, state::ReorderState, var::Int)
+    n = mgr.num_vars
+    level = mgr.perm[var]
+    limit = mgr.max_growth * mgr.num_nodes
+    best_size, best_level = mgr.num_nodes, level
+
+    # Take the shorter way first (+1 = down, -1 = up)
+    for dir in (n - level < level - 1 ? (1, -1) : (-1, 1))
+        while (dir == 1 && level < n) || (dir == -1 && level > 1)
+            size = swap_levels!(mgr, state, dir == 1 ? level : level - 1)
+            level += dir
+            if size < best_size
+                best_size, best_level = size, level
+            end
+            size > limit && break
+        end
+    end
+
+    while level < best_level
+        swap_levels!(mgr, state, level)
+        level += 1
+    end
+    while level > best_level
+        swap_levels!(mgr, state, level - 1)
+        level -= 1
+    end
+end
+
+"""
+    sift!(mgr::DDManager, state::ReorderState)
+
+Rudell's sifting: sift every variable in turn, largest levels first.
+"""
+function sift!(mgr::DDManager, state::ReorderState)
+    order = sortperm([mgr.unique_tables[mgr.perm[v]].keys for v in 1:mgr.num_vars]; rev = true)
+    for var in order
+        sift_variable!(mgr, state, var)
+    end
+end
+
+"""
+    window_permute!(mgr::DDManager, state::ReorderState, width::Int)
+
+Window permutation: try every order of each `width` adjacent levels
+(2 or 3) and keep the smallest, sweeping from top to bottom.
+"""
+function window_permute!(mgr::DDManager, state::ReorderState, width::Int)
+    for level in 1:mgr.num_vars - width + 1
+        if width == 2
+            size = mgr.num_nodes
+            if swap_levels!(mgr, state, level) >= size
+                swap_levels!(mgr, state, level)
+            end
+        else
+            # Alternating swaps walk through all 6 orders: abc bac bca cba cab acb
+            sizes = [mgr.num_nodes]
+            for k in 1:5
+                push!(sizes, swap_levels!(mgr, state, isodd(k) ? level : level + 1))
+            end
+            best = argmin(sizes) - 1
+            # Continue the cycle (step 6 returns to abc) up to the best order
+            if best != 5
+                for k in 6:6 + best
+                    swap_levels!(mgr, state, isodd(k) ? level : level + 1)
+                end
+            end
+        end
+    end
+end
+
+"""
+    reduce_heap!(mgr::DDManager, method::Symbol = mgr.reorder_method)
+
+Reorder the variables to shrink the diagrams, like CUDD's `Cudd_ReduceHeap`.
+`method` is `:sift` (Rudell's sifting), `:window2` or `:window3`.
+
+Reordering starts with [`garbage_collect!`](@ref), so only referenced nodes
+and the variable projections survive; their node ids remain valid and keep
+representing the same functions. The computed table is cleared.
+Reordering is not supported once ZDD nodes have been created.
+"""
+function reduce_heap!(mgr::DDManager, method::Symbol = mgr.reorder_method)
+    method in (:sift, :window2, :window3) ||
+        throw(ArgumentError("unknown reordering method: $method"))
+    mgr.has_zdd && throw(ArgumentError("variable reordering does not support ZDD nodes"))
+
+    garbage_collect!(mgr)
+    if mgr.num_vars > 1
+        # Swaps briefly need nodes beyond the current count; the limit is for operations
+        limit = mgr.max_nodes
+        mgr.max_nodes = typemax(Int)
+        try
+            state = ReorderState(mgr)
+            if method == :sift
+                sift!(mgr, state)
+            elseif method == :window2
+                window_permute!(mgr, state, 2)
+            elseif mgr.num_vars >= 3
+                window_permute!(mgr, state, 3)
+            else
+                window_permute!(mgr, state, 2)
+            end
+        finally
+            mgr.max_nodes = limit
+        end
+    end
+    clear_cache!(mgr)
+
+    mgr.reorder_pending = false
+    mgr.reorder_threshold = max(mgr.reorder_threshold, 2 * mgr.num_nodes)
+    return mgr
+end
+
+"""
+    enable_reordering!(mgr::DDManager; method::Symbol = :sift, threshold::Int = 4096)
+
+Turn on automatic reordering: once the manager holds `threshold` nodes a
+reordering becomes pending and runs at the next [`check_reorder`](@ref).
+After each run the threshold becomes twice the surviving node count.
+"""
+function enable_reordering!(mgr::DDManager; method::Symbol = :sift, threshold::Int = 4096)
+    mgr.auto_reorder = true
+    mgr.reorder_method = method
+    mgr.reorder_threshold = threshold
+    return mgr
+end
+
+"""
+    disable_reordering!(mgr::DDManager)
+
+Turn off automatic reordering.
+"""
+function disable_reordering!(mgr::DDManager)
+    mgr.auto_reorder = false
+    mgr.reorder_pending = false
+    return mgr
+end
+
+"""
+    check_reorder(mgr::DDManager)
+
+Run a pending automatic reordering. Operations never reorder on their own,
+since their intermediate results are not referenced; call this (like
+[`check_gc`](@ref)) between operations, with the live roots referenced.
+"""
+function check_reorder(mgr::DDManager)
+    if mgr.reorder_pending
+        reduce_heap!(mgr)
+    end
+end
@@ -0,0 +1,308 @@
+# Compact binary serialization of decision diagrams
+#
+# File layout (integers are LEB128 varints unless noted):
+#
+#   magic "AADD", format version (byte), flags (byte, bit 0 = ZDD nodes)
+#   number of variables, then the variable at each level
+#   number of terminals T, number of internal nodes N
+#   T terminal values (Float64 whatever the manager's value type, little-endian)
+#   number of level groups; per group its variable, its node count, and two
+#     edges per node. Groups run from the bottom level up, so every child is
+#     numbered (terminals 1:T, then nodes T+1:T+N in file order) before its
+#     parents, and an edge from node k to j is stored as (k - j) << 1 | complement
+#   number of roots, then each root as j << 1 | complement
+
+const DD_MAGIC = b"AADD"
+const DD_FORMAT_VERSION = 0x01
+const DD_FLAG_ZDD = 0x01
+
+@inline function write_varint(io::IO, x::UInt64)
+    n = 0
+    while x >= 0x80
+        n += write(io, (x % UInt8) | 0x80)
+        x >>= 7
+    end
+    return n + write(io, x % UInt8)
+end
+
+write_varint(io::IO, x::Integer) = write_varint(io, UInt64(x))
+
+"""
+    ByteReader
+
+Read cursor over the bytes of a serialized diagram (usually memory-mapped).
+"""
+mutable struct ByteReader{V<:AbstractVector{UInt8}}
+    bytes::V
+    pos::Int
+end
+
+corrupt_dd() = throw(ArgumentError("corrupt decision diagram data"))
+
+@inline function read_byte!(r::ByteReader)
+    r.pos <= length(r.bytes) || throw(ArgumentError("truncated decision diagram data"))
+    b = @inbounds r.bytes[r.pos]
+    r.pos += 1
+    return b
+end
+
+@inline function read_varint!(r::ByteReader)
+    x = UInt64(0)
+    shift = 0
+    while true
+        b = read_byte!(r)
+        shift < 64 || corrupt_dd()
+        x |= UInt64(b & 0x7f) << shift
+        b < 0x80 && return x
+        shift += 7
+    end
+end
+
+function read_float!(r::ByteReader)
+    x = UInt64(0)
+    for k in 0:7
+        x |= UInt64(read_byte!(r)) << (8k)
+    end
+    return reinterpret(Float64, x)
+end
+
+"""
+    write_dd(io::IO, mgr::DDManager, roots::AbstractVector{NodeId})
+
+Stream the diagrams rooted at `roots`, sharing one node table, to `io`.
+"""
+function write_dd(io::IO, mgr::DDManager, roots::AbstractVector{NodeId})
+    store = mgr.nodes
+    terminals = filter(idx -> store.index[idx] == TERMINAL_INDEX, reachable_slots(mgr, roots))
+    internal = bottom_up_slots(mgr, roots)
+
+    number = Dict{Int,Int}()
+    for (k, idx) in enumerate(terminals)
+        number[idx] = k
+    end
+    for (k, idx) in enumerate(internal)
+        number[idx] = length(terminals) + k
+    end
+
+    # Header
+    write(io, DD_MAGIC)
+    write(io, DD_FORMAT_VERSION)
+    write(io, mgr.has_zdd ? DD_FLAG_ZDD : 0x00)
+    write_varint(io, mgr.num_vars)
+    for var in mgr.invperm
+        write_varint(io, var)
+    end
+    write_varint(io, length(terminals))
+    write_varint(io, length(internal))
+    for idx in terminals
+        write(io, htol(reinterpret(UInt64, Float64(slot_value(mgr, idx)))))
+    end
+
+    # Level groups
+    groups = count(k -> k == 1 || store.index[internal[k]] != store.index[internal[k - 1]],
+                   1:length(internal))
+    write_varint(io, groups)
+    lo = 1
+    @inbounds while lo <= length(internal)
+        var = store.index[internal[lo]]
+        hi = lo
+        while hi < length(internal) && store.index[internal[hi + 1]] == var
+            hi += 1
+        end
+        write_varint(io, var)
+        write_varint(io, hi - lo + 1)
+        for k in lo:hi
+            idx = internal[k]
+            self = length(terminals) + k
+            for child in (store.then_child[idx], store.else_child[idx])
+                write_varint(io, UInt64(self - number[node_slot(child)]) << 1 | (child & 0x01))
+            end
+        end
+        lo = hi + 1
+    end
+
+    # Roots
+    write_varint(io, length(roots))
+    for root in roots
+        write_varint(io, UInt64(number[node_slot(root)]) << 1 | (root & 0x01))
+    end
+    return io
+end
+
+"""
+    read_dd_header!(r::ByteReader)
+
+Check the magic and version and return the flags and the stored variable
+order (the variable at each level).
+"""
+function read_dd_header!(r::ByteReader)
+    for b in DD_MAGIC
+        read_byte!(r) == b || throw(ArgumentError("not a decision diagram file"))
+    end
+    version = read_byte!(r)
+    version == DD_FORMAT_VERSION ||
+        throw(ArgumentError("unsupported decision diagram format version $version"))
+    flags = read_byte!(r)
+    num_vars = Int(read_varint!(r))
+    order = [Int(read_varint!(r)) for _ in 1:num_vars]
+    isperm(order) || corrupt_dd()
+    return flags, order
+end
+
+@inline function read_edge!(r::ByteReader, ids::Vector{NodeId}, self::Int)
+    code = read_varint!(r)
+    delta = code >> 1
+    1 <= delta < self || corrupt_dd()
+    return @inbounds ids[self - Int(delta)] ⊻ (code & 0x01)
+end
+
+"""
+    read_dd_body!(mgr::DDManager, r::ByteReader, flags::UInt8)
+
+Rebuild the nodes that follow the header in `mgr` and return the roots.
+Nodes go straight into the unique tables, so parts already present in the
+manager are shared rather than duplicated.
+"""
+function read_dd_body!(mgr::DDManager, r::ByteReader, flags::UInt8)
+    num_terminals = Int(read_varint!(r))
+    num_internal = Int(read_varint!(r))
+    store = mgr.nodes
+    ids = NodeId[]
+    sizehint!(ids, num_terminals + num_internal)
+    for column in (store.index, store.ref, store.then_child, store.else_child)
+        sizehint!(column, length(store) + num_internal + num_terminals)
+    end
+
+    for _ in 1:num_terminals
+        push!(ids, const_lookup(mgr, read_float!(r)))
+    end
+
+    flags & DD_FLAG_ZDD != 0 && (mgr.has_zdd = true)
+    for _ in 1:read_varint!(r)
+        var = Int(read_varint!(r))
+        1 <= var <= mgr.num_vars ||
+            throw(ArgumentError("variable $var is out of range for a manager with $(mgr.num_vars) variables"))
+        level = mgr.perm[var]
+        for _ in 1:read_varint!(r)
+            self = length(ids) + 1
+            self <= num_terminals + num_internal || corrupt_dd()
+            t = read_edge!(r, ids, self)
+            e = read_edge!(r, ids, self)
+            node_level(mgr, t) > level && node_level(mgr, e) > level ||
+                throw(ArgumentError("the file's variable order does not match the manager's"))
+            push!(ids, find_or_create_node!(mgr, var, t, e))
+        end
+    end
+    length(ids) == num_terminals + num_internal || corrupt_dd()
+
+    roots = NodeId[]
+    for _ in 1:read_varint!(r)
+        code = read_varint!(r)
+        1 <= code >> 1 <= length(ids) || corrupt_dd()
+        push!(roots, ids[Int(code >> 1)] ⊻ (code & 0x01))
+    end
+    return roots
+end
+
+"""
+    set_initial_order!(mgr::DDManager, order::Vector{Int})
+
+Put variable `order[l]` at level `l` in a manager that holds nothing but the
+projection functions, whose nodes are valid under any order.
+"""
+function set_initial_order!(mgr::DDManager, order::Vector{Int})
+    mgr.num_nodes == mgr.num_vars + 2 ||
+        throw(ArgumentError("the variable order can only be set on a new manager"))
+    tables = mgr.unique_tables[mgr.perm[order]]
+    mgr.unique_tables = tables
+    mgr.invperm = copy(order)
+    for (level, var) in enumerate(order)
+        mgr.perm[var] = level
+    end
+    return mgr
+end
+
+dd_bytes(path::AbstractString, mmap::Bool) = mmap ? Mmap.mmap(path) : read(path)
+dd_bytes(io::IO, ::Bool) = read(io)
+dd_bytes(bytes::AbstractVector{UInt8}, ::Bool) = bytes
+
+"""
+    save_dd(filename::AbstractString, mgr::DDManager, f::NodeId)
+    save_dd(io::IO, mgr::DDManager, f::NodeId)
+    save_dd(filename_or_io, mgr::DDManager, roots::AbstractVector{NodeId})
+
+Write the diagram `f` (BDD, ADD or ZDD) in a compact binary format: the
+nodes level by level from the bottom up, each child as a varint distance
+back to an already written node, and a table of the terminal values.
+The manager's variable order is stored with it. Terminal values are written
+as `Float64` whatever the manager's value type, and converted to the value
+type of the manager they are loaded into.
+
+Given a vector of roots, all of them go into one node table, so a
+subgraph they share is written once; the file is as large as
+`count_nodes(mgr, roots)` nodes. Load such files with [`load_dds`](@ref),
+single diagrams with [`load_dd`](@ref).
+"""
+function save_dd(io::IO, mgr::DDManager, roots::AbstractVector{NodeId})
+    write_dd(io, mgr, roots)
+    return nothing
+end
+
+save_dd(io::IO, mgr::DDManager, f::NodeId) = save_dd(io, mgr, [f])
+
+function save_dd(filename::AbstractString, mgr::DDManager, roots::Union{NodeId,AbstractVector{NodeId}})
+    open(io -> save_dd(io, mgr, roots), filename, "w")
+    return nothing
+end
+
+"""
+    load_dds(mgr::DDManager, source; mmap::Bool = true)
+    load_dds(source; mmap::Bool = true, kwargs...)
+
+Load all roots written by [`save_dd`](@ref) from a file name, an `IO` or a
+byte vector, as a `Vector{NodeId}` in the order they were saved.
+A file is memory-mapped unless `mmap = false`.
+
+The first form rebuilds the nodes in `mgr`. They go straight into the
+unique tables, so a root that already exists in `mgr` comes back as the
+same node id. The file must not need a variable above another that `mgr`'s
+order puts below it.
+
+The second form creates a `DDManager` (passing on `kwargs`) with the file's
+variables and order, and returns the manager and the roots. To load into a
+typed manager such as `DDManager{Int32}`, create it and use the first form.
+
+As with other operations, the returned roots are not referenced.
+"""
+function load_dds(mgr::DDManager, source; mmap::Bool = true)
+    r = ByteReader(dd_bytes(source, mmap), 1)
+    flags, _ = read_dd_header!(r)
+    return read_dd_body!(mgr, r, flags)
+end
+
+function load_dds(source; mmap::Bool = true, kwargs...)
+    r = ByteReader(dd_bytes(source, mmap), 1)
+    flags, order = read_dd_header!(r)
+    mgr = set_initial_order!(DDManager(length(order); kwargs...), order)
+    return mgr, read_dd_body!(mgr, r, flags)
+end
+
+function single_root(roots::Vector{NodeId})
+    length(roots) == 1 ||
+        throw(ArgumentError("the file holds $(length(roots)) roots; use load_dds"))
+    return roots[1]
+end
+
+"""
+    load_dd(mgr::DDManager, source; mmap::Bool = true)
+    load_dd(source; mmap::Bool = true, kwargs...)
+
+Load a single diagram written by [`save_dd`](@ref); like
+[`load_dds`](@ref), but returning the one root instead of a vector.
+"""
+load_dd(mgr::DDManager, source; mmap::Bool = true) = single_root(load_dds(mgr, source; mmap = mmap))
+
+function load_dd(source; mmap::Bool = true, kwargs...)
+    mgr, roots = load_dds(source; mmap = mmap, kwargs...)
+    return mgr, single_root(roots)
+end
@@ -0,0 +1,161 @@
+# Runtime statistics: unique-table, garbage-collector and node counters
+#
+# Collection is opt-in per manager. When it is off, the hot paths pay one
+# well-predicted test of `mgr.collect_stats` and touch no counters. The
+# per-operation computed-table counters of `cache_stats` are always kept.
+# With the "stats" preference set to false (STATS_COMPILED), all of these
+# tests are constant false and the counter updates are compiled out.
+
+@inline collecting_stats(mgr::DDManager) = STATS_COMPILED && mgr.collect_stats
+
+check_stats_compiled() = STATS_COMPILED ||
+    throw(ArgumentError("statistics are compiled out; set the \"stats\" preference of " *
+                        "AlgebraicDecisionDiagrams to true and restart Julia"))
+
+@inline function record_lookup!(table::UniqueTable, probes::Int)
+    table.lookups += 1
+    table.probes += probes
+end
+
+function record_gc!(mgr::DDManager, reclaimed::Int, start::UInt64)
+    stats = mgr.stats
+    stats.gc_runs += 1
+    stats.gc_time_ns += time_ns() - start
+    stats.gc_reclaimed += reclaimed
+end
+
+"""
+    enable_stats!(mgr::DDManager)
+
+Start collecting statistics: unique-table lookups and probe lengths per
+level, unique-table resizes, garbage collections with their time and
+reclaimed nodes, and the peak node count. Read them with
+[`unique_stats`](@ref), [`gc_stats`](@ref) or [`print_stats`](@ref).
+Counts taken during parallel operations are approximate. Throws an
+`ArgumentError` when the `"stats"` package preference has compiled the
+counters out.
+"""
+function enable_stats!(mgr::DDManager)
+    check_stats_compiled()
+    mgr.collect_stats = true
+    mgr.stats.peak_nodes = max(mgr.stats.peak_nodes, mgr.num_nodes)
+    return mgr
+end
+
+"""
+    disable_stats!(mgr::DDManager)
+
+Stop collecting statistics; the counters keep their values.
+"""
+function disable_stats!(mgr::DDManager)
+    mgr.collect_stats = false
+    return mgr
+end
+
+"""
+    reset_stats!(mgr::DDManager)
+
+Zero all counters, including the computed-table ones of
+[`reset_cache_stats!`](@ref). The peak node count restarts at the current
+node count.
+"""
+function reset_stats!(mgr::DDManager)
+    for table in mgr.unique_tables
+        table.lookups = 0
+        table.probes = 0
+        table.resizes = 0
+    end
+    mgr.stats = ManagerStats()
+    mgr.stats.peak_nodes = mgr.num_nodes
+    reset_cache_stats!(mgr)
+    return mgr
+end
+
+"""
+    unique_stats(mgr::DDManager)
+
+Per-level unique-table statistics as a vector of named tuples
+`(level, var, nodes, dead, buckets, lookups, avg_probe, resizes)`, where
+`avg_probe` is the mean number of occupied entries a lookup inspected.
+"""
+function unique_stats(mgr::DDManager)
+    return [(level = level, var = mgr.invperm[level], nodes = table.keys, dead = table.dead,
+             buckets = length(table.slots), lookups = table.lookups,
+             avg_probe = table.lookups == 0 ? 0.0 : table.probes / table.lookups,
+             resizes = table.resizes)
+            for (level, table) in enumerate(mgr.unique_tables)]
+end
+
+"""
+    gc_stats(mgr::DDManager)
+
+Garbage-collector and node statistics as a named tuple
+`(runs, time, reclaimed, peak_nodes)`, with `time` in seconds.
+"""
+function gc_stats(mgr::DDManager)
+    stats = mgr.stats
+    return (runs = stats.gc_runs, time = stats.gc_time_ns / 1e9,
+            reclaimed = stats.gc_reclaimed, peak_nodes = stats.peak_nodes)
+end
+
+"""
+    memory_in_use(mgr::DDManager)
+
+Approximate bytes held by the node store, the terminal values, the unique
+tables and the computed table. The unique tables are counted by their
+buckets, so the nodes only add the store's columns.
+"""
+function memory_in_use(mgr::DDManager{T}) where {T}
+    buckets = sum(table -> length(table.slots), mgr.unique_tables; init = 0) +
+              length(mgr.const_table.slots)
+    return STORE_NODE_BYTES * length(mgr.nodes) + sizeof(T) * length(mgr.values) +
+           sizeof(UInt64) * buckets + sizeof(CacheEntry) * length(mgr.cache.entries)
+end
+
+"""
+    print_stats([io::IO], mgr::DDManager)
+
+Print a report on the manager in the spirit of CUDD's `Cudd_PrintInfo`:
+sizes and limits, computed-table use per operation, unique-table use per
+level, and garbage collection. Unique-table and collector counters need
+[`enable_stats!`](@ref).
+"""
+function print_stats(io::IO, mgr::DDManager)
+    cache = mgr.cache
+    gc = gc_stats(mgr)
+    println(io, "**** Decision diagram manager statistics ****")
+    println(io, "Statistics collection: ",
+            !STATS_COMPILED ? "compiled out" : mgr.collect_stats ? "on" : "off")
+    println(io, "Variables: ", mgr.num_vars)
+    println(io, "Nodes: ", mgr.num_nodes, " (", mgr.num_dead, " dead, ",
+            length(mgr.free_list), " free slots, peak ", gc.peak_nodes, ")")
+    println(io, "Node limit: ", mgr.max_nodes == typemax(Int) ? "none" : mgr.max_nodes)
+    println(io, "Memory in use: ", memory_in_use(mgr), " bytes")
+
+    println(io, "Computed table: ", length(cache.entries), " entries, ", cache.ways,
+            "-way, max ", cache.max_size, ", ", cache.resizes, " resizes")
+    for s in cache_stats(mgr)
+        rate = s.lookups == 0 ? 0.0 : 100 * s.hits / s.lookups
+        println(io, "  ", rpad(s.op, 14), " lookups ", s.lookups, ", hits ", s.hits,
+                " (", round(rate; digits = 1), "%), evictions ", s.evictions)
+    end
+
+    levels = unique_stats(mgr)
+    lookups = sum(l -> l.lookups, levels; init = 0)
+    probes = sum(t -> t.probes, mgr.unique_tables; init = 0)
+    println(io, "Unique tables: ", lookups, " lookups, average probe ",
+            round(lookups == 0 ? 0.0 : probes / lookups; digits = 2), ", ",
+            sum(l -> l.resizes, levels; init = 0), " resizes")
+    for l in levels
+        l.nodes > 0 || l.lookups > 0 || continue
+        println(io, "  level ", l.level, " (var ", l.var, "): ", l.nodes, " nodes, ",
+                l.dead, " dead, ", l.buckets, " buckets, ", l.lookups, " lookups, probe ",
+                round(l.avg_probe; digits = 2), ", ", l.resizes, " resizes")
+    end
+
+    println(io, "Garbage collections: ", gc.runs, ", ", round(gc.time; digits = 6),
+            " s, ", gc.reclaimed, " nodes reclaimed")
+    return nothing
+end
+
+print_stats(mgr::DDManager) = print_stats(stdout, mgr)
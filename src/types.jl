@@ -3,8 +3,10 @@
 """
     NodeId
 
-A node identifier that encodes both the node reference and complement bit.
-The LSB is used for complement edges (BDD only).
+A node identifier that encodes the node reference, a terminal tag and
+the complement bit.
+The LSB is used for complement edges (BDD only); bit 1 is set for terminal
+nodes, so terminal checks need only the id.
 """
 const NodeId = UInt64
 
@@ -13,100 +15,291 @@ const NodeId = UInt64
 @inline regular(id::NodeId) = id & ~UInt64(0x01)
 @inline complement(id::NodeId) = id ⊻ UInt64(0x01)
 
+# Terminal tag
+const TERMINAL_TAG = UInt64(0x02)
+@inline is_terminal_id(id::NodeId) = (id & TERMINAL_TAG) != 0
+
+# Slot <-> NodeId conversion (slot index shifted left past the tag and complement bits)
+@inline node_slot(id::NodeId) = Int(id >> 2)
+@inline slot_id(slot::Integer) = NodeId(slot) << 2
+@inline terminal_id(slot::Integer) = (NodeId(slot) << 2) | TERMINAL_TAG
+
 # Special node IDs
 const INVALID_NODE = typemax(NodeId)
-const ZERO_NODE = UInt64(0)
-const ONE_NODE = UInt64(2)  # Regular pointer to terminal 1
+const ONE_NODE = terminal_id(1)        # Regular pointer to terminal 1
+const ZERO_NODE = complement(ONE_NODE) # Complemented pointer to terminal 1
+
+# Variable index stored in terminal slots
+const TERMINAL_INDEX = typemax(UInt32)
 
 """
     DDNode
 
-Internal representation of a decision diagram node.
-For terminal nodes, stores a value. For internal nodes, stores children.
+Snapshot of a decision diagram node, as returned by `get_node`.
+Nodes live column-wise in a `NodeStore`; this isbits struct is
+materialized on demand and never allocated on the heap.
+For a terminal, `then_child` is the position of its constant in the
+manager's value table (see [`terminal_value`](@ref)).
 """
-mutable struct DDNode
+struct DDNode
     index::UInt32           # Variable index (MAXUINT32 for terminals)
     ref::UInt32             # Reference count
     then_child::NodeId      # High/Then child
     else_child::NodeId      # Low/Else child
-    value::Float64          # Terminal value (for ADDs)
-    next::UInt64            # Next node in unique table collision chain (node index)
 end
 
-# Constructor for internal nodes
-DDNode(index::Integer, then_child::NodeId, else_child::NodeId) =
-    DDNode(UInt32(index), UInt32(0), then_child, else_child, 0.0, 0)
+@inline is_terminal(node::DDNode) = node.index == TERMINAL_INDEX
+
+"""
+    NodeStore
+
+Struct-of-arrays node storage. Slot `i` of every column describes node `i`;
+all columns are isbits vectors, so the store holds no heap pointers and
+updating a reference count is a plain store. The unique tables refer to
+slots but keep no links in the store, and terminal constants live in the
+manager's value table, so no node carries a value field.
+"""
+struct NodeStore
+    index::Vector{UInt32}       # Variable index (TERMINAL_INDEX for terminals)
+    ref::Vector{UInt32}         # Reference count
+    then_child::Vector{NodeId}  # High/Then child (value-table position for terminals)
+    else_child::Vector{NodeId}  # Low/Else child
+end
 
-# Constructor for terminal nodes
-DDNode(value::Float64) =
-    DDNode(typemax(UInt32), UInt32(0), INVALID_NODE, INVALID_NODE, value, 0)
+NodeStore() = NodeStore(UInt32[], UInt32[], NodeId[], NodeId[])
 
-@inline is_terminal(node::DDNode) = node.index == typemax(UInt32)
+# Unique-table entries hold a slot in 32 bits
+const MAX_NODE_SLOTS = Int(typemax(UInt32))
+
+Base.length(store::NodeStore) = length(store.index)
+
+@inline function Base.getindex(store::NodeStore, i::Integer)
+    @boundscheck checkbounds(store.index, i)
+    @inbounds DDNode(store.index[i], store.ref[i], store.then_child[i], store.else_child[i])
+end
+
+"""
+    push_node!(store::NodeStore, index, then_child, else_child)
+
+Append a node to the store and return its slot index.
+"""
+function push_node!(store::NodeStore, index::UInt32, then_child::NodeId, else_child::NodeId)
+    push!(store.index, index)
+    push!(store.ref, UInt32(0))
+    push!(store.then_child, then_child)
+    push!(store.else_child, else_child)
+    return length(store.index)
+end
 
 """
     UniqueTable
 
 Hash table for ensuring node uniqueness (hash consing).
 One subtable per variable level.
+
+Open addressing with linear probing: each entry packs a 32-bit hash
+fingerprint above the node's 32-bit slot index (0 = empty), so a probe
+sequence is scanned without loading nodes and the table is rehashed from
+the fingerprints alone.
 """
 mutable struct UniqueTable
-    slots::Vector{UInt64}   # Hash buckets (stores node indices, 0 = empty)
-    shift::Int              # Shift amount for hash function
+    slots::Vector{UInt64}   # Entries: fingerprint << 32 | slot index (0 = empty)
+    shift::Int              # Fingerprint bits dropped to get the home bucket
     keys::Int               # Number of nodes at this level
     dead::Int               # Number of dead nodes
+
+    # Counters kept while the manager collects statistics
+    lookups::Int            # Searches
+    probes::Int             # Occupied entries inspected by the searches
+    resizes::Int
 end
 
 function UniqueTable(initial_size::Int = 256)
-    shift = 64 - trailing_zeros(initial_size)
-    UniqueTable(zeros(UInt64, initial_size), shift, 0, 0)
+    shift = 32 - trailing_zeros(initial_size)
+    UniqueTable(zeros(UInt64, initial_size), shift, 0, 0, 0, 0, 0)
+end
+
+"""
+    STATS_COMPILED
+
+Whether the statistics counters are compiled in at all, from the package
+preference `"stats"` (default `true`). After
+`Preferences.set_preferences!(AlgebraicDecisionDiagrams, "stats" => false)`
+and a restart, every counter update, including the per-operation
+computed-table counters, folds away at compile time.
+"""
+const STATS_COMPILED = @load_preference("stats", true)::Bool
+
+"""
+    ManagerStats
+
+Manager-wide counters kept while statistics are enabled
+(see [`enable_stats!`](@ref)); the per-level ones live in the unique tables
+and the per-operation ones in the computed table.
+"""
+mutable struct ManagerStats
+    gc_runs::Int
+    gc_time_ns::UInt64
+    gc_reclaimed::Int
+    peak_nodes::Int
 end
 
+ManagerStats() = ManagerStats(0, UInt64(0), 0, 0)
+
 """
     CacheEntry
 
 Entry in the computed table for caching operation results.
 """
 struct CacheEntry
+    op::UInt64     # Operation tag
     f::NodeId
     g::NodeId
-    h::UInt64      # Third operand or operation tag
+    h::UInt64      # Third operand (0 when unused)
     result::NodeId
+    epoch::UInt32  # Cache epoch the entry was written in
 end
 
-CacheEntry() = CacheEntry(INVALID_NODE, INVALID_NODE, 0, INVALID_NODE)
+CacheEntry() = CacheEntry(0, INVALID_NODE, INVALID_NODE, 0, INVALID_NODE, 0)
+
+# Per-operation cache counters: one slot per built-in tag, user tags share the last
+const CACHE_STAT_SLOTS = 256
 
 """
     ComputedTable
 
 Cache for memoizing operation results.
+
+Entries are grouped into sets of `ways` consecutive entries; `ways == 1` is
+a direct-mapped cache. With `ways > 1` every entry carries a last-use stamp
+and insertion replaces the least recently used way of the set.
+
+Only entries written in the current `epoch` are valid, so clearing the table
+is a matter of advancing the epoch.
 """
 mutable struct ComputedTable
     entries::Vector{CacheEntry}
+    stamps::Vector{UInt32}     # Last-use stamp per entry (empty when direct-mapped)
     shift::Int
+    ways::Int                  # Associativity (entries per set)
+    nsets::Int                 # Number of sets
+    clock::UInt32              # Aging clock, advanced on every insertion
+    epoch::UInt32              # Entries from older epochs are stale
+
+    # Per-operation counters, indexed by (cache_stat_slot(op), row). Threaded
+    # managers give every thread a row of its own, so no count is lost to a race
+    lookups::Matrix{Int}
+    hits::Matrix{Int}
+    evictions::Matrix{Int}
+
+    # Growth policy: double (up to max_size) once a window has seen more misses
+    # than there are entries while the hit ratio stayed above min_hit
+    max_size::Int
+    min_hit::Float64
+    window_lookups::Int
+    window_hits::Int
+    resizes::Int
+    frozen::Bool               # Growth suspended (parallel operations in flight)
 end
 
-function ComputedTable(size::Int = 262144)
+function ComputedTable(size::Int = 16384; ways::Int = 1, max_size::Int = size,
+                       min_hit::Float64 = 0.3, stat_rows::Int = 1)
+    ways in (1, 2, 4, 8) || throw(ArgumentError("cache ways must be 1, 2, 4 or 8"))
+    ispow2(size) && size >= ways || throw(ArgumentError("cache size must be a power of two ≥ ways"))
     shift = 64 - trailing_zeros(size)
-    ComputedTable([CacheEntry() for _ in 1:size], shift)
+    stamps = ways == 1 ? UInt32[] : zeros(UInt32, size)
+    ComputedTable([CacheEntry() for _ in 1:size], stamps, shift, ways, size ÷ ways,
+                  UInt32(0), UInt32(1), zeros(Int, CACHE_STAT_SLOTS, stat_rows),
+                  zeros(Int, CACHE_STAT_SLOTS, stat_rows), zeros(Int, CACHE_STAT_SLOTS, stat_rows),
+                  max(size, max_size), min_hit, 0, 0, 0, false)
+end
+
+"""
+    ApplyFrame
+
+Work item of the iterative apply engine. `var == FRAME_EXPAND` asks for the
+operands to be expanded; a positive `var` builds a node on that variable
+from the two topmost results and caches it under the operands. The other
+kinds finish a subproblem in other ways:
+
+- `FRAME_PASS` caches the topmost result as it is;
+- `FRAME_COMBINE` caches the operator's combination of the two topmost
+  results (the OR of quantification), `FRAME_COMBINE_SELF` that of the
+  topmost result with itself;
+- `FRAME_EXPAND_RHS` expands the operands as the second argument of a
+  combination, unless the first result already decides it;
+- `FRAME_NOT` complements the topmost result, without caching.
+"""
+struct ApplyFrame
+    f::NodeId
+    g::NodeId
+    h::NodeId
+    var::Int
+end
+
+const FRAME_EXPAND = 0
+const FRAME_PASS = -1
+const FRAME_COMBINE = -2
+const FRAME_COMBINE_SELF = -3
+const FRAME_EXPAND_RHS = -4
+const FRAME_NOT = -5
+
+"""
+    ApplyStacks
+
+Frame and result stacks of the iterative apply engine, reused across calls.
+"""
+struct ApplyStacks
+    frames::Vector{ApplyFrame}
+    results::Vector{NodeId}
 end
 
+ApplyStacks() = ApplyStacks(ApplyFrame[], NodeId[])
+
+"""
+    CompiledADD
+
+Flat copy of an ADD for batch evaluation, built by [`compile_add`](@ref).
+Internal nodes are numbered in level order, so a root-to-leaf walk only moves
+forward through the arrays. A child `c > 0` is internal node `c`; a child
+`c <= 0` is the terminal `values[1 - c]`.
 """
-    DDManager
+struct CompiledADD{T<:Real}
+    var::Vector{Int32}         # Variable tested by each internal node
+    then_child::Vector{Int32}
+    else_child::Vector{Int32}
+    values::Vector{T}          # Terminal values
+    root::Int32
+    num_vars::Int              # Largest variable index tested (0 for a constant)
+end
+
+"""
+    DDManager{T}
 
 Main manager for decision diagrams. Handles node allocation,
 unique table, computed table, and variable ordering.
+ADD terminals hold values of type `T` (`Float64` by default).
 """
-mutable struct DDManager
+mutable struct DDManager{T<:Real}
     # Node storage
-    nodes::Vector{DDNode}
+    nodes::NodeStore
     free_list::Vector{UInt64}  # Indices of free nodes
+    values::Vector{T}          # Terminal constants, indexed by the terminal slot's then_child
 
     # Unique table (one per variable level)
     unique_tables::Vector{UniqueTable}
 
+    # Constant (terminal) unique table, keyed by value
+    const_table::UniqueTable
+    epsilon::Float64       # Tolerance for merging ADD constants (0 = exact)
+
     # Computed table (shared cache)
     cache::ComputedTable
 
+    # Cache tags of user-registered ADD operators
+    op_tags::IdDict{Any,UInt64}
+    next_op_tag::UInt64
+
     # Variable ordering
     num_vars::Int
     perm::Vector{Int}      # index -> level
@@ -115,7 +308,8 @@ mutable struct DDManager
 
     # Constants
     zero::NodeId
-    one::NodeId
+    one::NodeId            # Also the ADD constant 1.0
+    add_zero::NodeId       # ADD constant 0.0
 
     # Statistics
     num_nodes::Int
@@ -124,30 +318,95 @@ mutable struct DDManager
     # GC parameters
     gc_frac::Float64       # Trigger GC when dead/total > gc_frac
     max_cache_size::Int
+
+    # Statistics collection (off unless enabled)
+    collect_stats::Bool
+    stats::ManagerStats
+
+    # Resource limits
+    max_nodes::Int         # Live and dead nodes an operation may grow the store to
+    limit_depth::Int       # Limited operations in progress (only the outermost recovers)
+
+    # Garbage collector scratch space, reused between collections
+    gc_marks::BitVector    # Mark bit per node slot
+    gc_stack::Vector{Int}  # Marking worklist
+    gc_live::Int           # Nodes left by the last collection (growth since is possible garbage)
+
+    # Handles dropped by their finalizers, dereferenced at the next safe point
+    released::Vector{NodeId}
+    release_lock::Threads.SpinLock
+
+    # Dynamic variable reordering
+    auto_reorder::Bool
+    reorder_method::Symbol
+    reorder_threshold::Int # Node count at which an automatic reordering becomes pending
+    reorder_pending::Bool
+    max_growth::Float64    # Sifting abandons a direction beyond this size factor
+    has_zdd::Bool          # ZDD nodes exist (they cannot be reordered)
+
+    # Concurrency (only used when threaded)
+    threaded::Bool
+    level_locks::Vector{Threads.SpinLock}  # One per unique-table level
+    cache_locks::Vector{Threads.SpinLock}  # Stripes over computed-table sets
+    alloc_lock::ReentrantLock              # Free list and node store growth
+    const_lock::ReentrantLock              # Constant table
+    node_capacity::Int     # Slots the store may hold without reallocating
+
+    # Iterative apply engine stacks (single-threaded managers)
+    apply_stacks::ApplyStacks
 end
 
+# Number of lock stripes over the computed table (a power of two)
+const CACHE_LOCK_STRIPES = 256
+
 """
-    DDManager(num_vars::Int)
+    DDManager(num_vars::Int; cache_size::Int = 16384, max_cache_size::Int = 1 << 20,
+              cache_ways::Int = 1, epsilon::Float64 = 0.0, threaded::Bool = false,
+              max_nodes::Int = typemax(Int), max_memory::Int = 0, stats::Bool = false)
+    DDManager{T}(num_vars::Int; kwargs...)
 
 Create a new decision diagram manager with the specified number of variables.
+The first form holds `Float64` ADD constants; `DDManager{Int32}(n)` or
+`DDManager{Float32}(n)` store narrower ones, and ADD operations on the
+manager compute in `T`.
+The computed table starts with `cache_size` entries and doubles, up to
+`max_cache_size`, while it sees many misses at a good hit rate
+(see [`set_max_cache_size!`](@ref)).
+`cache_ways` selects the associativity of the computed table (1 = direct-mapped,
+or 2/4/8-way with least-recently-used replacement).
+With `epsilon > 0`, ADD constants closer than `epsilon` share one terminal.
+With `threaded = true` the unique and computed tables are guarded by striped
+locks, so the `parallel_*` operations (e.g. [`parallel_and`](@ref)) can run on
+the manager; single-threaded managers skip all locking.
+`max_nodes` and `max_memory` (in bytes, 0 for none) bound the node store;
+see [`set_node_limit!`](@ref). `stats = true` starts with statistics
+collection on (see [`enable_stats!`](@ref)).
 """
-function DDManager(num_vars::Int; cache_size::Int = 262144)
+DDManager(num_vars::Int; kwargs...) = DDManager{Float64}(num_vars; kwargs...)
+
+function DDManager{T}(num_vars::Int; cache_size::Int = 16384, max_cache_size::Int = 1 << 20,
+                      cache_ways::Int = 1, epsilon::Float64 = 0.0, threaded::Bool = false,
+                      max_nodes::Int = typemax(Int), max_memory::Int = 0,
+                      stats::Bool = false) where {T<:Real}
+    stats && check_stats_compiled()
     # Initialize node storage with terminal node
     # In BDDs with complement edges, we only need one terminal (1)
     # Zero is represented as the complement of one
-    nodes = DDNode[]
-    push!(nodes, DDNode(1.0))  # Index 1: terminal 1
+    nodes = NodeStore()
+    push_node!(nodes, TERMINAL_INDEX, NodeId(1), INVALID_NODE)  # Slot 1: terminal 1, values[1]
 
-    # zero = complemented pointer to terminal 1 (index 1, shifted left, with complement bit)
-    # one = regular pointer to terminal 1 (index 1, shifted left, no complement bit)
-    zero = NodeId((1 << 1) | 1)  # Complemented pointer to node 1
-    one = NodeId(1 << 1)          # Regular pointer to node 1
+    # zero_id = complemented pointer to terminal 1 (index 1, shifted left, with complement bit)
+    # one_id = regular pointer to terminal 1 (index 1, shifted left, no complement bit)
+    zero_id = ZERO_NODE  # Complemented pointer to node 1
+    one_id = ONE_NODE    # Regular pointer to node 1
 
     # Initialize unique tables (one per variable)
     unique_tables = [UniqueTable() for _ in 1:num_vars]
 
     # Initialize cache
-    cache = ComputedTable(cache_size)
+    max_cache_size = max(cache_size, max_cache_size)
+    cache = ComputedTable(cache_size; ways = cache_ways, max_size = max_cache_size,
+                          stat_rows = threaded ? Threads.maxthreadid() : 1)
 
     # Initialize variable ordering (identity)
     perm = collect(1:num_vars)
@@ -156,27 +415,60 @@ function DDManager(num_vars::Int; cache_size::Int = 262144)
     # Create variable projection functions
     vars = NodeId[]
 
-    manager = DDManager(
+    manager = DDManager{T}(
         nodes,
         UInt64[],
+        T[one(T)],
         unique_tables,
+        UniqueTable(),
+        epsilon,
         cache,
+        IdDict{Any,UInt64}(),
+        OP_USER_BASE,
         num_vars,
         perm,
         invperm,
         vars,
-        zero,
-        one,
+        zero_id,
+        one_id,
+        INVALID_NODE,  # ADD zero, created below
         1,  # One terminal node
         0,
         0.2,
-        cache_size
+        max_cache_size,
+        stats,
+        ManagerStats(),
+        node_limit(max_nodes, max_memory),
+        0,
+        BitVector(),
+        Int[],
+        0,
+        NodeId[],
+        Threads.SpinLock(),
+        false,
+        :sift,
+        4096,
+        false,
+        1.2,
+        false,
+        threaded,
+        threaded ? [Threads.SpinLock() for _ in 1:num_vars] : Threads.SpinLock[],
+        threaded ? [Threads.SpinLock() for _ in 1:CACHE_LOCK_STRIPES] : Threads.SpinLock[],
+        ReentrantLock(),
+        ReentrantLock(),
+        typemax(Int),
+        ApplyStacks()
     )
 
+    # Register terminal 1 in the constant table
+    insert_const!(manager, 1, const_key(one(T), epsilon))
+    manager.add_zero = const_lookup(manager, zero(T))
+
     # Create projection functions for each variable
     for i in 1:num_vars
         push!(manager.vars, ith_var(manager, i))
     end
+    manager.gc_live = manager.num_nodes
 
     return manager
 end
@@ -4,14 +4,94 @@
 const HASH_P1 = UInt64(12582917)
 const HASH_P2 = UInt64(4256249)
 
+# Multiplier for Fibonacci hashing: spreads entropy into the high bits
+const HASH_CONST = 0x9e3779b97f4a7c15
+
+"""
+    hash_node(then_child::NodeId, else_child::NodeId)
+
+Hash of a node's children for unique table lookup; the variable is implied
+by the table.
+"""
+@inline function hash_node(then_child::NodeId, else_child::NodeId)
+    return (then_child * HASH_P1 + else_child * HASH_P2) * HASH_CONST
+end
+
+# Unique-table entries (see `UniqueTable`). The fingerprint is the hash's
+# top 32 bits with the lowest forced on, so no entry is 0; its top bits are
+# the home bucket, so rehashing needs no node loads.
+@inline fingerprint(h::UInt64) = UInt32(h >> 32) | 0x00000001
+@inline table_entry(fp::UInt32, node_idx::Integer) = UInt64(fp) << 32 | UInt64(node_idx)
+@inline entry_fingerprint(entry::UInt64) = UInt32(entry >> 32)
+@inline entry_slot(entry::UInt64) = Int(entry % UInt32)
+
+@inline home_bucket(table::UniqueTable, fp::UInt32) = Int(fp >> table.shift) + 1
+@inline next_bucket(table::UniqueTable, i::Int) = (i & (length(table.slots) - 1)) + 1
+
+# Linear probing stays short up to a load of 3/4
+@inline table_full(table::UniqueTable) = 4 * table.keys > 3 * length(table.slots)
+
+"""
+    insert_entry!(table::UniqueTable, entry::UInt64)
+
+Put an entry in the first free bucket of its probe sequence. The caller
+makes sure the node is not in the table yet.
+"""
+@inline function insert_entry!(table::UniqueTable, entry::UInt64)
+    slots = table.slots
+    i = home_bucket(table, entry_fingerprint(entry))
+    @inbounds while slots[i] != 0
+        i = next_bucket(table, i)
+    end
+    @inbounds slots[i] = entry
+    table.keys += 1
+end
+
 """
-    hash_node(then_child::NodeId, else_child::NodeId, shift::Int)
+    remove_entry!(table::UniqueTable, fp::UInt32, node_idx::Int)
 
-Hash function for unique table lookup.
+Remove the entry of `node_idx` (with fingerprint `fp`) and close the gap by
+shifting later entries of the probe run back, so no tombstones are left.
 """
-@inline function hash_node(then_child::NodeId, else_child::NodeId, shift::Int)
-    h = (regular(then_child) * HASH_P1 + regular(else_child)) * HASH_P2
-    return (h >> shift) + 1  # +1 for 1-based indexing
+function remove_entry!(table::UniqueTable, fp::UInt32, node_idx::Int)
+    slots = table.slots
+    i = home_bucket(table, fp)
+    @inbounds while entry_slot(slots[i]) != node_idx
+        i = next_bucket(table, i)
+    end
+    j = i
+    @inbounds while true
+        j = next_bucket(table, j)
+        entry = slots[j]
+        entry == 0 && break
+        # The entry may fill the hole unless its home lies cyclically in (i, j]
+        h = home_bucket(table, entry_fingerprint(entry))
+        if i <= j ? !(i < h <= j) : !(h > i || h <= j)
+            slots[i] = entry
+            i = j
+        end
+    end
+    @inbounds slots[i] = 0
+    table.keys -= 1
+end
+
+"""
+    rehash_table!(keep, table::UniqueTable, new_size::Int)
+
+Rebuild `table` with `new_size` buckets, keeping the entries whose slot
+index satisfies `keep`. Entries are placed by their fingerprints, so no
+node is loaded.
+"""
+function rehash_table!(keep::F, table::UniqueTable, new_size::Int) where {F}
+    old_slots = table.slots
+    table.slots = zeros(UInt64, new_size)
+    table.shift = 32 - trailing_zeros(new_size)
+    table.keys = 0
+    @inbounds for entry in old_slots
+        if entry != 0 && keep(entry_slot(entry))
+            insert_entry!(table, entry)
+        end
+    end
 end
 
 """
@@ -19,6 +99,8 @@ end
 
 Look up or create a unique node with the given variable and children.
 Implements the reduction rule: if then_child == else_child, return then_child.
+Stored then-edges are never complemented, so a complemented then-child is
+pushed to the incoming edge and every function has a single representation.
 """
 function unique_lookup(mgr::DDManager, var_index::Int, then_child::NodeId, else_child::NodeId)
     # Reduction rule: if both children are the same, return that child
@@ -26,111 +108,326 @@ function unique_lookup(mgr::DDManager, var_index::Int, then_child::NodeId, else_
         return then_child
     end
 
+    # Canonical form: ¬(v ? ¬t : ¬e) == (v ? t : e)
+    if is_complemented(then_child)
+        return complement(find_or_create_node!(mgr, var_index, complement(then_child),
+                                               complement(else_child)))
+    end
+
+    return find_or_create_node!(mgr, var_index, then_child, else_child)
+end
+
+"""
+    find_or_create_node!(mgr::DDManager, var_index::Int, then_child::NodeId, else_child::NodeId)
+
+Hash-consing core shared by the BDD, ADD and ZDD lookups: probe the unique
+table of the variable's level for an identical node and create one if missing.
+No reduction rule is applied here. In a threaded manager the level's lock is
+held for the whole search-and-insert, so no node is ever created twice.
+"""
+@inline function find_or_create_node!(mgr::DDManager, var_index::Int,
+                                      then_child::NodeId, else_child::NodeId)
+    if mgr.threaded
+        lk = mgr.level_locks[mgr.perm[var_index]]
+        lock(lk)
+        try
+            return find_or_create_unlocked!(mgr, var_index, then_child, else_child)
+        finally
+            unlock(lk)
+        end
+    end
+    return find_or_create_unlocked!(mgr, var_index, then_child, else_child)
+end
+
+@inline function find_or_create_unlocked!(mgr::DDManager, var_index::Int,
+                                          then_child::NodeId, else_child::NodeId)
     level = mgr.perm[var_index]
     table = mgr.unique_tables[level]
-
-    # Compute hash
-    h = hash_node(then_child, else_child, table.shift)
-    slot_idx = Int(((h - 1) % length(table.slots)) + 1)
-
-    # Search collision chain
-    node_idx = table.slots[slot_idx]
-    while node_idx != 0
-        node = mgr.nodes[node_idx]
-        if node.index == var_index &&
-           node.then_child == then_child &&
-           node.else_child == else_child
-            # Found existing node
-            return NodeId(node_idx << 1)  # Convert to NodeId (shift left, clear complement bit)
+    store = mgr.nodes
+
+    # Probe from the home bucket; only a matching fingerprint loads the node
+    fp = fingerprint(hash_node(then_child, else_child))
+    i = home_bucket(table, fp)
+    probes = 0
+    @inbounds while true
+        entry = table.slots[i]
+        entry == 0 && break
+        probes += 1
+        if entry_fingerprint(entry) == fp
+            node_idx = entry_slot(entry)
+            if store.then_child[node_idx] == then_child && store.else_child[node_idx] == else_child
+                # Found existing node
+                collecting_stats(mgr) && record_lookup!(table, probes)
+                return slot_id(node_idx)
+            end
         end
-        node_idx = node.next
+        i = next_bucket(table, i)
     end
+    collecting_stats(mgr) && record_lookup!(table, probes)
 
-    # Node not found, create new one
-    return create_node!(mgr, var_index, then_child, else_child, table, slot_idx)
+    # Node not found, create it in the free bucket that ended the search
+    return create_node!(mgr, var_index, then_child, else_child, table, i, fp)
 end
 
 """
     create_node!(mgr::DDManager, var_index::Int, then_child::NodeId, else_child::NodeId,
-                 table::UniqueTable, slot_idx::Int)
+                 table::UniqueTable, bucket::Int, fp::UInt32)
 
-Create a new node and insert it into the unique table.
+Create a new node and enter it into the free `bucket` of the unique table.
 """
 function create_node!(mgr::DDManager, var_index::Int, then_child::NodeId, else_child::NodeId,
-                      table::UniqueTable, slot_idx::Int)
-    # Allocate node
+                      table::UniqueTable, bucket::Int, fp::UInt32)
+    node_idx = alloc_slot!(mgr, UInt32(var_index), then_child, else_child)
+    @inbounds table.slots[bucket] = table_entry(fp, node_idx)
+    table.keys += 1
+
+    # Check if resize needed
+    if table_full(table)
+        resize_unique_table!(mgr, table)
+    end
+
+    return slot_id(node_idx)
+end
+
+"""
+    NodeCapacityExceeded
+
+Thrown by a threaded allocation that would grow the node store past the
+capacity reserved for the current parallel operation, which is then rerun
+with a larger reservation.
+"""
+struct NodeCapacityExceeded <: Exception end
+
+"""
+    NodeLimitExceeded(limit::Int)
+
+Thrown when an operation needs more than the manager's `limit` nodes even
+after garbage collection and reordering (see [`set_node_limit!`](@ref)).
+The operation is abandoned; the nodes it built are dead and the manager
+stays usable.
+"""
+struct NodeLimitExceeded <: Exception
+    limit::Int
+end
+
+Base.showerror(io::IO, err::NodeLimitExceeded) =
+    print(io, "NodeLimitExceeded: the operation needs more than $(err.limit) nodes")
+
+"""
+    alloc_slot!(mgr::DDManager, index::UInt32, then_child::NodeId, else_child::NodeId)
+
+Take a node slot from the free list or append one to the store, and fill it.
+"""
+@inline function alloc_slot!(mgr::DDManager, index::UInt32, then_child::NodeId,
+                             else_child::NodeId)
+    if mgr.threaded
+        lock(mgr.alloc_lock)
+        try
+            # Appending past the reservation could move the columns under readers
+            if isempty(mgr.free_list) && length(mgr.nodes) >= mgr.node_capacity
+                throw(NodeCapacityExceeded())
+            end
+            return take_slot!(mgr, index, then_child, else_child)
+        finally
+            unlock(mgr.alloc_lock)
+        end
+    end
+    return take_slot!(mgr, index, then_child, else_child)
+end
+
+@inline function take_slot!(mgr::DDManager, index::UInt32, then_child::NodeId,
+                            else_child::NodeId)
+    mgr.num_nodes >= mgr.max_nodes && throw(NodeLimitExceeded(mgr.max_nodes))
+    store = mgr.nodes
     if !isempty(mgr.free_list)
-        node_idx = pop!(mgr.free_list)
-        node = mgr.nodes[node_idx]
-        node.index = UInt32(var_index)
-        node.ref = UInt32(0)
-        node.then_child = then_child
-        node.else_child = else_child
-        node.value = 0.0
+        node_idx = Int(pop!(mgr.free_list))
+        @inbounds begin
+            store.index[node_idx] = index
+            store.ref[node_idx] = UInt32(0)
+            store.then_child[node_idx] = then_child
+            store.else_child[node_idx] = else_child
+        end
     else
-        node = DDNode(var_index, then_child, else_child)
-        push!(mgr.nodes, node)
-        node_idx = length(mgr.nodes)
+        length(store) < MAX_NODE_SLOTS || throw(NodeLimitExceeded(MAX_NODE_SLOTS))
+        node_idx = push_node!(store, index, then_child, else_child)
     end
 
-    # Insert at head of collision chain
-    node = mgr.nodes[node_idx]
-    node.next = table.slots[slot_idx]
-    table.slots[slot_idx] = node_idx
-
-    table.keys += 1
     mgr.num_nodes += 1
+    if collecting_stats(mgr) && mgr.num_nodes > mgr.stats.peak_nodes
+        mgr.stats.peak_nodes = mgr.num_nodes
+    end
+    if mgr.auto_reorder && mgr.num_nodes >= mgr.reorder_threshold
+        mgr.reorder_pending = true
+    end
+    return node_idx
+end
 
-    # Check if resize needed
-    if table.keys > length(table.slots) * 4
-        resize_unique_table!(mgr, mgr.perm[var_index])
+"""
+    resize_unique_table!(mgr::DDManager, table::UniqueTable)
+
+Double a unique table that became too full.
+"""
+function resize_unique_table!(mgr::DDManager, table::UniqueTable)
+    collecting_stats(mgr) && (table.resizes += 1)
+    rehash_table!(_ -> true, table, 2 * length(table.slots))
+end
+
+"""
+    bucket_key(x::Real)
+
+Hash key for a constant: the bit pattern of a float, with -0.0 and 0.0
+identified, or the value of an integer. Other types fall back to `hash`.
+"""
+@inline bucket_key(x::Float64) = x == 0.0 ? UInt64(0) : reinterpret(UInt64, x)
+@inline bucket_key(x::Union{Float16,Float32}) = x == 0 ? UInt64(0) : UInt64(reinterpret(Unsigned, x))
+@inline bucket_key(x::Base.BitInteger) = x % UInt64
+bucket_key(x::Real) = hash(x)
+
+"""
+    const_key(value::Real, epsilon::Float64)
+
+Hash key of a constant: its bit pattern in exact mode, or the bit pattern of
+its `epsilon`-wide bucket in tolerance mode.
+"""
+@inline function const_key(value::Real, epsilon::Float64)
+    if epsilon > 0.0
+        return bucket_key(floor(value / epsilon))
     end
+    return bucket_key(value)
+end
+
+@inline hash_const(key::UInt64) = (key ⊻ (key >> 32)) * HASH_CONST
+
+# Tolerance test in Float64, so an integer difference cannot wrap around
+@inline within_epsilon(a::Real, b::Real, epsilon::Float64) =
+    abs(Float64(a) - Float64(b)) < epsilon
+
+"""
+    find_const(mgr::DDManager{T}, key::UInt64, value::T)
 
-    return NodeId(node_idx << 1)
+Search the constant table for `key`. Returns INVALID_NODE if no terminal
+matches `value` (exactly, or within `mgr.epsilon` in tolerance mode).
+"""
+@inline function find_const(mgr::DDManager{T}, key::UInt64, value::T) where {T}
+    table = mgr.const_table
+    epsilon = mgr.epsilon
+
+    fp = fingerprint(hash_const(key))
+    i = home_bucket(table, fp)
+    @inbounds while true
+        entry = table.slots[i]
+        entry == 0 && break
+        if entry_fingerprint(entry) == fp
+            node_idx = entry_slot(entry)
+            v = slot_value(mgr, node_idx)
+            if epsilon > 0.0 ? (v == value || within_epsilon(v, value, epsilon)) : (v == value || isequal(v, value))
+                return terminal_id(node_idx)
+            end
+        end
+        i = next_bucket(table, i)
+    end
+    return INVALID_NODE
 end
 
 """
-    resize_unique_table!(mgr::DDManager, level::Int)
+    const_lookup(mgr::DDManager{T}, value::Real)
 
-Resize a unique table when it becomes too dense.
+Look up or create the terminal node holding `value`, converted to `T`.
+In tolerance mode the neighbouring buckets are searched as well, so any
+existing constant within `mgr.epsilon` is returned.
 """
-function resize_unique_table!(mgr::DDManager, level::Int)
-    table = mgr.unique_tables[level]
+function const_lookup(mgr::DDManager{T}, value::Real) where {T}
+    value = convert(T, value)
+    if mgr.threaded
+        lock(mgr.const_lock)
+        try
+            return const_lookup_unlocked(mgr, value)
+        finally
+            unlock(mgr.const_lock)
+        end
+    end
+    return const_lookup_unlocked(mgr, value)
+end
+
+function const_lookup_unlocked(mgr::DDManager{T}, value::T) where {T}
+    epsilon = mgr.epsilon
+    if epsilon > 0.0
+        bucket = floor(value / epsilon)
+        for b in (bucket, bucket - 1.0, bucket + 1.0)
+            id = find_const(mgr, bucket_key(b), value)
+            if id != INVALID_NODE
+                return id
+            end
+        end
+        key = bucket_key(bucket)
+    else
+        key = bucket_key(value)
+        id = find_const(mgr, key, value)
+        if id != INVALID_NODE
+            return id
+        end
+    end
+
+    # Create new terminal node; its then_child is the value's position
+    node_idx = alloc_slot!(mgr, TERMINAL_INDEX, NodeId(length(mgr.values) + 1), INVALID_NODE)
+    push!(mgr.values, value)
+    insert_const!(mgr, node_idx, key)
+
+    return terminal_id(node_idx)
+end
+
+"""
+    insert_const!(mgr::DDManager, node_idx::Integer, key::UInt64)
+
+Insert a terminal slot into the constant table, growing it when too dense.
+"""
+function insert_const!(mgr::DDManager, node_idx::Integer, key::UInt64)
+    table = mgr.const_table
+    insert_entry!(table, table_entry(fingerprint(hash_const(key)), node_idx))
+    if table_full(table)
+        rehash_table!(_ -> true, table, 2 * length(table.slots))
+    end
+end
+
+"""
+    rehash_const_table!(mgr::DDManager, new_size::Int)
+
+Rebuild the constant table with `new_size` buckets, recomputing every key
+from the current `mgr.epsilon`.
+"""
+function rehash_const_table!(mgr::DDManager, new_size::Int)
+    table = mgr.const_table
     old_slots = table.slots
-    new_size = length(old_slots) * 2
 
-    # Create new table
     table.slots = zeros(UInt64, new_size)
-    table.shift = 64 - trailing_zeros(new_size)
+    table.shift = 32 - trailing_zeros(new_size)
     table.keys = 0
 
-    # Rehash all nodes
-    for old_slot in old_slots
-        node_idx = old_slot
-        while node_idx != 0
-            node = mgr.nodes[node_idx]
-            next_idx = node.next
-
-            # Reinsert node
-            h = hash_node(node.then_child, node.else_child, table.shift)
-            new_slot = ((h - 1) % new_size) + 1
-            node.next = table.slots[new_slot]
-            table.slots[new_slot] = node_idx
-            table.keys += 1
-
-            node_idx = next_idx
-        end
+    for entry in old_slots
+        entry == 0 && continue
+        node_idx = entry_slot(entry)
+        key = const_key(slot_value(mgr, node_idx), mgr.epsilon)
+        insert_entry!(table, table_entry(fingerprint(hash_const(key)), node_idx))
     end
 end
 
 """
     get_node(mgr::DDManager, id::NodeId)
 
-Get the node corresponding to a NodeId, handling complement edges.
+Get a snapshot of the node corresponding to a NodeId (complement bit ignored).
 """
 @inline function get_node(mgr::DDManager, id::NodeId)
-    node_idx = regular(id) >> 1
-    return mgr.nodes[node_idx]
+    return mgr.nodes[node_slot(id)]
+end
+
+"""
+    is_terminal(mgr::DDManager, id::NodeId)
+
+Check whether a NodeId refers to a terminal node. Only the id's terminal
+tag is read, never the node store.
+"""
+@inline function is_terminal(::DDManager, id::NodeId)
+    return is_terminal_id(id)
 end
 
 """
@@ -139,7 +436,7 @@ end
 Get the variable index of a node.
 """
 @inline function node_index(mgr::DDManager, id::NodeId)
-    return get_node(mgr, id).index
+    return mgr.nodes.index[node_slot(id)]
 end
 
 """
@@ -148,11 +445,10 @@ end
 Get the level of a node in the variable ordering.
 """
 @inline function node_level(mgr::DDManager, id::NodeId)
-    node = get_node(mgr, id)
-    if is_terminal(node)
+    if is_terminal_id(id)
         return typemax(Int)
     end
-    return mgr.perm[node.index]
+    return mgr.perm[mgr.nodes.index[node_slot(id)]]
 end
 
 """
@@ -161,8 +457,7 @@ end
 Get the then (high) child of a node.
 """
 @inline function then_child(mgr::DDManager, id::NodeId)
-    node = get_node(mgr, id)
-    child = node.then_child
+    child = mgr.nodes.then_child[node_slot(id)]
     # Handle complement edge
     if is_complemented(id)
         return complement(child)
@@ -176,8 +471,7 @@ end
 Get the else (low) child of a node.
 """
 @inline function else_child(mgr::DDManager, id::NodeId)
-    node = get_node(mgr, id)
-    child = node.else_child
+    child = mgr.nodes.else_child[node_slot(id)]
     # Handle complement edge
     if is_complemented(id)
         return complement(child)
@@ -185,17 +479,34 @@ Get the else (low) child of a node.
     return child
 end
 
+"""
+    raw_then(mgr::DDManager, id::NodeId)
+    raw_else(mgr::DDManager, id::NodeId)
+
+Stored children of a node without complement-edge handling (ADD/ZDD paths).
+"""
+@inline raw_then(mgr::DDManager, id::NodeId) = mgr.nodes.then_child[node_slot(id)]
+@inline raw_else(mgr::DDManager, id::NodeId) = mgr.nodes.else_child[node_slot(id)]
+
+"""
+    terminal_value(mgr::DDManager{T}, id::NodeId)
+
+The constant of type `T` held by terminal `id`, looked up in the manager's
+value table (the complement bit is ignored).
+"""
+@inline terminal_value(mgr::DDManager, id::NodeId) = slot_value(mgr, node_slot(id))
+@inline slot_value(mgr::DDManager, idx::Int) = @inbounds mgr.values[mgr.nodes.then_child[idx]]
+
 """
     node_value(mgr::DDManager, id::NodeId)
 
 Get the value of a terminal node.
 """
 @inline function node_value(mgr::DDManager, id::NodeId)
-    node = get_node(mgr, id)
-    val = node.value
+    val = terminal_value(mgr, id)
     # Handle complement edge for BDDs
     if is_complemented(id)
-        return 1.0 - val
+        return one(val) - val
     end
     return val
 end
@@ -209,9 +520,10 @@ function ref!(mgr::DDManager, id::NodeId)
     if id == mgr.zero || id == mgr.one
         return  # Don't ref terminals
     end
-    node = get_node(mgr, id)
-    if node.ref < typemax(UInt32)
-        node.ref += 1
+    refs = mgr.nodes.ref
+    i = node_slot(id)
+    if refs[i] < typemax(UInt32)
+        refs[i] += 1
     end
 end
 
@@ -224,11 +536,17 @@ function deref!(mgr::DDManager, id::NodeId)
     if id == mgr.zero || id == mgr.one
         return  # Don't deref terminals
     end
-    node = get_node(mgr, id)
-    if node.ref > 0 && node.ref < typemax(UInt32)
-        node.ref -= 1
-        if node.ref == 0
+    refs = mgr.nodes.ref
+    i = node_slot(id)
+    if refs[i] > 0 && refs[i] < typemax(UInt32)
+        refs[i] -= 1
+        if refs[i] == 0
+            # Now garbage unless still reachable from another root
             mgr.num_dead += 1
+            index = mgr.nodes.index[i]
+            if index != TERMINAL_INDEX
+                mgr.unique_tables[mgr.perm[index]].dead += 1
+            end
         end
     end
 end
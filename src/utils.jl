@@ -2,32 +2,36 @@
 
 """
     count_nodes(mgr::DDManager, f::NodeId)
+    count_nodes(mgr::DDManager, roots::AbstractVector{NodeId})
 
 Count the number of nodes in a BDD/ADD (excluding terminals).
+For a vector of roots, nodes shared between them are counted once, like
+CUDD's `Cudd_SharingSize`.
 """
 function count_nodes(mgr::DDManager, f::NodeId)
-    visited = Set{NodeId}()
-    return count_nodes_rec(mgr, f, visited)
+    return count_new_nodes!(mgr, f, Set{NodeId}(), NodeId[])
 end
 
-function count_nodes_rec(mgr::DDManager, f::NodeId, visited::Set{NodeId})
-    f_reg = regular(f)
-
-    if f_reg in visited
-        return 0
-    end
+function count_nodes(mgr::DDManager, roots::AbstractVector{NodeId})
+    visited = Set{NodeId}()
+    stack = NodeId[]
+    return sum(f -> count_new_nodes!(mgr, f, visited, stack), roots; init = 0)
+end
 
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return 0
+# Internal nodes reachable from f and not yet in `visited`, which gains them;
+# walks an explicit stack
+function count_new_nodes!(mgr::DDManager, f::NodeId, visited::Set{NodeId}, stack::Vector{NodeId})
+    count = 0
+    push!(stack, f)
+    while !isempty(stack)
+        g = pop!(stack)
+        is_terminal(mgr, g) && continue
+        g_reg = regular(g)
+        g_reg in visited && continue
+        push!(visited, g_reg)
+        count += 1
+        push!(stack, raw_then(mgr, g_reg), raw_else(mgr, g_reg))
     end
-
-    push!(visited, f_reg)
-    count = 1
-
-    count += count_nodes_rec(mgr, node.then_child, visited)
-    count += count_nodes_rec(mgr, node.else_child, visited)
-
     return count
 end
 
@@ -46,7 +50,7 @@ function count_paths(mgr::DDManager, f::NodeId)
 
     node = get_node(mgr, f)
     if is_terminal(node)
-        return node.value != 0.0 ? 1 : 0
+        return iszero(terminal_value(mgr, f)) ? 0 : 1
     end
 
     # Handle complement edge
@@ -57,52 +61,185 @@ function count_paths(mgr::DDManager, f::NodeId)
 end
 
 """
-    count_minterms(mgr::DDManager, f::NodeId, nvars::Int)
+    reachable_slots(mgr::DDManager, roots)
 
-Count the number of satisfying assignments (minterms) for a BDD.
+Slots of all nodes reachable from `roots`, each listed once.
 """
-function count_minterms(mgr::DDManager, f::NodeId, nvars::Int)
-    cache = Dict{NodeId, Float64}()
-    return count_minterms_rec(mgr, f, nvars, nvars, cache)
+function reachable_slots(mgr::DDManager, roots)
+    store = mgr.nodes
+    seen = falses(length(store))
+    slots = Int[]
+    stack = Int[]
+    for root in roots
+        idx = node_slot(root)
+        if !seen[idx]
+            seen[idx] = true
+            push!(stack, idx)
+        end
+        @inbounds while !isempty(stack)
+            idx = pop!(stack)
+            push!(slots, idx)
+            store.index[idx] == TERMINAL_INDEX && continue
+            for child in (store.then_child[idx], store.else_child[idx])
+                c = node_slot(child)
+                if !seen[c]
+                    seen[c] = true
+                    push!(stack, c)
+                end
+            end
+        end
+    end
+    return slots
 end
 
-function count_minterms_rec(mgr::DDManager, f::NodeId, nvars::Int, total_vars::Int, cache::Dict{NodeId, Float64})
-    f_reg = regular(f)
+"""
+    bottom_up_slots(mgr::DDManager, roots)
 
-    if haskey(cache, f_reg)
-        result = cache[f_reg]
-        return is_complemented(f) ? 2.0^nvars - result : result
+Slots of the internal nodes reachable from `roots`, bucketed by level from
+the bottom up, so every node comes after its children.
+"""
+function bottom_up_slots(mgr::DDManager, roots)
+    store = mgr.nodes
+    internal = filter(idx -> store.index[idx] != TERMINAL_INDEX, reachable_slots(mgr, roots))
+
+    # Counting sort on the level
+    start = zeros(Int, mgr.num_vars)
+    @inbounds for idx in internal
+        start[mgr.perm[store.index[idx]]] += 1
+    end
+    pos = 1
+    for level in mgr.num_vars:-1:1
+        pos, start[level] = pos + start[level], pos
+    end
+    sorted = similar(internal)
+    @inbounds for idx in internal
+        level = mgr.perm[store.index[idx]]
+        sorted[start[level]] = idx
+        start[level] += 1
     end
+    return sorted
+end
 
-    if f == mgr.zero
-        return 0.0
+# Arithmetic of the counting kernels: plain numbers of type T, or log2 of them
+struct LinearCounts{T} end
+struct Log2Counts end
+
+count_type(::LinearCounts{T}) where {T} = T
+count_type(::Log2Counts) = Float64
+
+@inline count_zero(::LinearCounts{T}) where {T} = zero(T)
+@inline count_zero(::Log2Counts) = -Inf
+@inline count_one(::LinearCounts{T}) where {T} = one(T)
+@inline count_one(::Log2Counts) = 0.0
+
+# x + y (overflow-checked for fixed-width integers)
+@inline count_add(::LinearCounts{T}, x, y) where {T<:Base.BitInteger} = Base.checked_add(x, y)
+@inline count_add(::LinearCounts, x, y) = x + y
+@inline function count_add(::Log2Counts, x, y)
+    hi, lo = max(x, y), min(x, y)
+    return hi == -Inf ? hi : hi + log2(1.0 + exp2(lo - hi))
+end
+
+# Value bits of a fixed-width integer type: 2^k fits for k < count_bits(T)
+@inline count_bits(::Type{T}) where {T<:Base.BitInteger} = 8 * sizeof(T) - (T <: Signed ? 1 : 0)
+
+# x * 2^k (overflow-checked for fixed-width integers)
+@inline function count_scale(::LinearCounts{T}, x, k::Int) where {T<:Base.BitInteger}
+    iszero(x) || k + 8 * sizeof(T) - leading_zeros(x) <= count_bits(T) ||
+        throw(OverflowError("$x * 2^$k does not fit in $T"))
+    return x << k
+end
+@inline count_scale(::LinearCounts{T}, x, k::Int) where {T<:Integer} = x << k
+@inline count_scale(::LinearCounts, x, k::Int) = ldexp(x, k)
+@inline count_scale(::Log2Counts, x, k::Int) = x + k
+
+# 2^k - x (overflow-checked for fixed-width integers)
+@inline function count_complement(::LinearCounts{T}, x, k::Int) where {T<:Base.BitInteger}
+    k < count_bits(T) && return (one(T) << k) - x
+    # 2^k itself does not fit, but 2^k - x may
+    k == count_bits(T) && !iszero(x) && return (typemax(T) - x) + one(T)
+    throw(OverflowError("2^$k - $x does not fit in $T"))
+end
+@inline count_complement(::LinearCounts{T}, x, k::Int) where {T<:Integer} = (one(T) << k) - x
+@inline count_complement(::LinearCounts, x, k::Int) = ldexp(one(x), k) - x
+@inline count_complement(::Log2Counts, x, k::Int) = x == -Inf ? Float64(k) : k + log2(-expm1((x - k) * log(2.0)))
+
+# Count along an edge into `child` from a node at `from_level`, over the
+# levels from_level+1 .. nvars
+@inline function minterm_edge(space, mgr::DDManager, counts::Vector, child::NodeId,
+                              from_level::Int, nvars::Int)
+    store = mgr.nodes
+    idx = node_slot(child)
+    if is_terminal_id(child)
+        level = nvars + 1
+        base = iszero(slot_value(mgr, idx)) ? count_zero(space) : count_one(space)
+    else
+        level = @inbounds mgr.perm[store.index[idx]]
+        base = @inbounds counts[idx]
     end
-    if f == mgr.one
-        return 2.0^nvars
+    if is_complemented(child)
+        base = count_complement(space, base, nvars - level + 1)
     end
+    return count_scale(space, base, level - from_level - 1)
+end
 
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        val = is_complemented(f) ? -node.value : node.value
-        return val != 0.0 ? 2.0^nvars : 0.0
+"""
+    minterm_count(space, mgr::DDManager, f::NodeId, nvars::Int)
+
+Count the minterms of `f` over the levels `1:nvars` in the number system
+`space`. Nodes are visited bottom-up with their counts in an array indexed
+by node slot; the count of a node covers the levels from its own down.
+"""
+function minterm_count(space, mgr::DDManager, f::NodeId, nvars::Int)
+    store = mgr.nodes
+    order = bottom_up_slots(mgr, (f,))
+    counts = Vector{count_type(space)}(undef, length(store))
+    @inbounds for idx in order
+        level = mgr.perm[store.index[idx]]
+        level <= nvars ||
+            throw(ArgumentError("the diagram tests level $level, beyond nvars = $nvars"))
+        t = minterm_edge(space, mgr, counts, store.then_child[idx], level, nvars)
+        e = minterm_edge(space, mgr, counts, store.else_child[idx], level, nvars)
+        counts[idx] = count_add(space, t, e)
     end
+    return minterm_edge(space, mgr, counts, f, 0, nvars)
+end
 
-    level = mgr.perm[node.index]
+"""
+    count_minterms(mgr::DDManager, f::NodeId, nvars::Int)
+    count_minterms(::Type{T}, mgr::DDManager, f::NodeId, nvars::Int)
 
-    t = then_child(mgr, f)
-    e = else_child(mgr, f)
+Count the number of satisfying assignments (minterms) of a BDD over the
+variables at levels `1:nvars`. For an ADD, the assignments reaching a
+nonzero terminal are counted.
 
-    # Number of variables below this node's level (not including this variable)
-    vars_below = total_vars - level
+The count is exact. It is computed in `UInt128` and only redone with
+`BigInt` if that overflows, as [`zdd_count`](@ref) does. The second form
+counts in `T` instead, e.g. `Float64` (rounded, and `Inf` above `2^1023`);
+a fixed-width integer `T` throws an `OverflowError` rather than wrap. See
+[`log_count_minterms`](@ref) for huge counts.
+"""
+function count_minterms(mgr::DDManager, f::NodeId, nvars::Int)
+    try
+        return minterm_count(LinearCounts{UInt128}(), mgr, f, nvars)
+    catch err
+        err isa OverflowError || rethrow()
+        return minterm_count(LinearCounts{BigInt}(), mgr, f, nvars)
+    end
+end
 
-    # Recurse with remaining variables below this level
-    count_t = count_minterms_rec(mgr, t, vars_below, total_vars, cache)
-    count_e = count_minterms_rec(mgr, e, vars_below, total_vars, cache)
+function count_minterms(::Type{T}, mgr::DDManager, f::NodeId, nvars::Int) where {T<:Real}
+    return minterm_count(LinearCounts{T}(), mgr, f, nvars)
+end
 
-    result = count_t + count_e
-    cache[f_reg] = result
+"""
+    log_count_minterms(mgr::DDManager, f::NodeId, nvars::Int)
 
-    return result
+Base-2 logarithm of [`count_minterms`](@ref), computed in log space so it
+neither overflows nor allocates big integers; `-Inf` for an unsatisfiable `f`.
+"""
+function log_count_minterms(mgr::DDManager, f::NodeId, nvars::Int)
+    return minterm_count(Log2Counts(), mgr, f, nvars)
 end
 
 """
@@ -138,7 +275,7 @@ function print_dd_rec(mgr::DDManager, f::NodeId, depth::Int, max_depth::Int, vis
     node = get_node(mgr, f)
 
     if is_terminal(node)
-        val = is_comp ? -node.value : node.value
+        val = is_comp ? -terminal_value(mgr, f) : terminal_value(mgr, f)
         println(indent, "Terminal: ", val)
         return
     end
@@ -198,7 +335,7 @@ function to_dot_nodes(mgr::DDManager, f::NodeId, io::IO, visited::Set{NodeId},
     node = get_node(mgr, f)
 
     if is_terminal(node)
-        println(io, "  node", node_ids[f_reg], " [label=\"", node.value, "\", shape=box];")
+        println(io, "  node", node_ids[f_reg], " [label=\"", terminal_value(mgr, f), "\", shape=box];")
         return
     end
 
@@ -248,69 +385,89 @@ end
     garbage_collect!(mgr::DDManager)
 
 Perform garbage collection to reclaim dead nodes.
+
+Nodes with a positive reference count and the variable projections are the
+roots; everything they do not reach is returned to the free list. Marking
+uses a bit per slot and an explicit worklist, both kept in the manager and
+reused, so a collection runs in time linear in the node store, does no
+hashing, and never recurses.
 """
 function garbage_collect!(mgr::DDManager)
-    # Mark phase: mark all reachable nodes
-    marked = Set{UInt64}()
+    start = collecting_stats(mgr) ? time_ns() : UInt64(0)
+    store = mgr.nodes
+    n = length(store)
 
-    # Mark from all nodes with positive reference count
-    for (idx, node) in enumerate(mgr.nodes)
-        if node.ref > 0
-            mark_reachable!(mgr, NodeId(idx << 1), marked)
+    # Mark phase: mark all reachable nodes
+    marks = mgr.gc_marks
+    resize!(marks, n)
+    fill!(marks, false)
+    stack = mgr.gc_stack
+    empty!(stack)
+
+    @inbounds for idx in 1:n
+        # Terminals are never swept; marking them keeps their cache entries
+        if store.ref[idx] > 0 || store.index[idx] == TERMINAL_INDEX
+            mark_slot!(marks, stack, idx)
         end
     end
+    for v in mgr.vars
+        mark_slot!(marks, stack, node_slot(v))
+    end
+    mark_reachable!(mgr, marks, stack)
 
     # Sweep phase: collect unmarked nodes
+    num_freed = 0
     for level in 1:mgr.num_vars
         table = mgr.unique_tables[level]
-        for slot_idx in 1:length(table.slots)
-            prev_idx = UInt64(0)
-            node_idx = table.slots[slot_idx]
-
-            while node_idx != 0
-                node = mgr.nodes[node_idx]
-                next_idx = node.next
-
-                if node_idx ∉ marked && node.ref == 0
-                    # Remove from chain
-                    if prev_idx == 0
-                        table.slots[slot_idx] = next_idx
-                    else
-                        mgr.nodes[prev_idx].next = next_idx
-                    end
-
-                    # Add to free list
-                    push!(mgr.free_list, node_idx)
-                    table.keys -= 1
-                    table.dead -= 1
-                    mgr.num_nodes -= 1
-                    mgr.num_dead -= 1
-                else
-                    prev_idx = node_idx
-                end
-
-                node_idx = next_idx
+        level_freed = 0
+        @inbounds for entry in table.slots
+            entry == 0 && continue
+            node_idx = entry_slot(entry)
+            if !marks[node_idx]
+                # Add to free list
+                push!(mgr.free_list, node_idx)
+                level_freed += 1
             end
         end
+
+        # Re-place the survivors by fingerprint, which closes the gaps
+        if level_freed > 0
+            rehash_table!(idx -> @inbounds(marks[idx]), table, length(table.slots))
+            mgr.num_nodes -= level_freed
+            num_freed += level_freed
+        end
+        table.dead = 0
     end
+    mgr.num_dead = 0
+    mgr.gc_live = mgr.num_nodes
 
-    # Clear cache after GC
-    clear_cache!(mgr)
+    # Forget only the cached results that refer to reclaimed slots
+    if num_freed > 0
+        invalidate_cache!(mgr, marks)
+    end
+    collecting_stats(mgr) && record_gc!(mgr, num_freed, start)
 end
 
-function mark_reachable!(mgr::DDManager, f::NodeId, marked::Set{UInt64})
-    node_idx = regular(f) >> 1
-
-    if node_idx in marked
-        return
+@inline function mark_slot!(marks::BitVector, stack::Vector{Int}, idx::Int)
+    @inbounds if !marks[idx]
+        marks[idx] = true
+        push!(stack, idx)
     end
+end
 
-    push!(marked, node_idx)
+"""
+    mark_reachable!(mgr::DDManager, marks::BitVector, stack::Vector{Int})
 
-    node = mgr.nodes[node_idx]
-    if !is_terminal(node)
-        mark_reachable!(mgr, node.then_child, marked)
-        mark_reachable!(mgr, node.else_child, marked)
+Mark every slot reachable from the slots on `stack`, draining it.
+"""
+function mark_reachable!(mgr::DDManager, marks::BitVector, stack::Vector{Int})
+    store = mgr.nodes
+    @inbounds while !isempty(stack)
+        idx = pop!(stack)
+        if store.index[idx] != TERMINAL_INDEX
+            mark_slot!(marks, stack, node_slot(store.then_child[idx]))
+            mark_slot!(marks, stack, node_slot(store.else_child[idx]))
+        end
     end
 end
 
@@ -324,3 +481,111 @@ function check_gc(mgr::DDManager)
         garbage_collect!(mgr)
     end
 end
+
+# Bytes of the node store's columns per node
+const STORE_NODE_BYTES = 2 * sizeof(UInt32) + 2 * sizeof(NodeId)
+
+# Approximate bytes per node: the store's columns plus its unique-table entry at a typical load
+const NODE_BYTES = 36
+
+node_limit(max_nodes::Int, max_memory::Int) =
+    max_memory > 0 ? min(max_nodes, max(max_memory ÷ NODE_BYTES, 1)) : max_nodes
+
+"""
+    set_node_limit!(mgr::DDManager, max_nodes::Int = typemax(Int))
+
+Bound the node store at `max_nodes` nodes, live or dead, like CUDD's
+`maxLive`. An operation that would go past the limit is stopped; the
+manager then collects garbage and reruns it, then reorders (if automatic
+reordering is on) and reruns it, and throws [`NodeLimitExceeded`](@ref)
+if it still does not fit. Only referenced nodes and the operation's
+operands survive the collection. Call without a limit to lift it.
+"""
+function set_node_limit!(mgr::DDManager, max_nodes::Int = typemax(Int))
+    max_nodes > 0 || throw(ArgumentError("the node limit must be positive"))
+    mgr.max_nodes = max_nodes
+    return mgr
+end
+
+"""
+    set_memory_limit!(mgr::DDManager, bytes::Int)
+
+Bound the node store at about `bytes` bytes, like CUDD's `maxMemory`
+(0 lifts the limit). This sets the node limit of
+[`set_node_limit!`](@ref) at 36 bytes per node; the computed
+table is bounded separately by [`set_max_cache_size!`](@ref).
+"""
+function set_memory_limit!(mgr::DDManager, bytes::Int)
+    bytes >= 0 || throw(ArgumentError("the memory limit must not be negative"))
+    mgr.max_nodes = node_limit(typemax(Int), bytes)
+    return mgr
+end
+
+# Node operands of a limited operation
+const Operands = Union{Tuple,AbstractVector{NodeId}}
+
+"""
+    with_node_limit(body, mgr::DDManager, operands)
+
+Run the operation `body()` on `operands` (a tuple, or a vector for
+operations with many) under the manager's node limit.
+Without a limit, or inside another limited operation (whose unreferenced
+intermediate results a collection would free), this is just `body()`.
+"""
+@inline function with_node_limit(body::F, mgr::DDManager, operands::Operands) where {F}
+    if mgr.max_nodes == typemax(Int) || mgr.limit_depth > 0
+        return body()
+    end
+    return limited_call(body, mgr, operands)
+end
+
+function limited_call(body::F, mgr::DDManager, operands::Operands) where {F}
+    mgr.limit_depth += 1
+    try
+        stage = 0
+        while true
+            try
+                return body()
+            catch err
+                err isa NodeLimitExceeded || rethrow()
+                stage = recover_nodes!(mgr, operands, stage)
+                stage == 0 && rethrow()
+            end
+        end
+    finally
+        mgr.limit_depth -= 1
+    end
+end
+
+"""
+    recover_nodes!(mgr::DDManager, operands, stage::Int)
+
+Make room to rerun an operation that hit the node limit: garbage-collect
+at stage 0, reorder at stage 1, with the operands protected. Return the
+next stage, or 0 when nothing was freed and the operation must give up.
+"""
+function recover_nodes!(mgr::DDManager, operands::Operands, stage::Int)
+    protected = [id for id in operands if 0 < node_slot(id) <= length(mgr.nodes)]
+    # The counts are put back as they were rather than deref'd, which would
+    # count an unreferenced operand as a new dead node
+    saved = [mgr.nodes.ref[node_slot(id)] for id in protected]
+    foreach(id -> ref!(mgr, id), protected)
+    try
+        if stage == 0
+            before = mgr.num_nodes
+            garbage_collect!(mgr)
+            mgr.num_nodes < before && return 1
+            stage = 1
+        end
+        if stage == 1 && mgr.auto_reorder && !mgr.has_zdd
+            before = mgr.num_nodes
+            reduce_heap!(mgr)
+            mgr.num_nodes < before && return 2
+        end
+        return 0
+    finally
+        for (id, count) in zip(protected, saved)
+            mgr.nodes.ref[node_slot(id)] = count
+        end
+    end
+end
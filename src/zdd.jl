@@ -33,27 +33,8 @@ function zdd_unique_lookup(mgr::DDManager, var_index::Int, then_child::NodeId, e
     end
 
     # Otherwise use standard unique lookup
-    level = mgr.perm[var_index]
-    table = mgr.unique_tables[level]
-
-    # Compute hash
-    h = hash_node(then_child, else_child, table.shift)
-    slot_idx = Int(((h - 1) % length(table.slots)) + 1)
-
-    # Search collision chain
-    node_idx = table.slots[slot_idx]
-    while node_idx != 0
-        node = mgr.nodes[node_idx]
-        if node.index == var_index &&
-           node.then_child == then_child &&
-           node.else_child == else_child
-            return NodeId(node_idx << 1)
-        end
-        node_idx = node.next
-    end
-
-    # Create new node
-    return create_node!(mgr, var_index, then_child, else_child, table, slot_idx)
+    mgr.has_zdd = true
+    return find_or_create_node!(mgr, var_index, then_child, else_child)
 end
 
 """
@@ -72,59 +53,7 @@ end
 Compute the union of two ZDD sets: f ∪ g
 """
 function zdd_union(mgr::DDManager, f::NodeId, g::NodeId)
-    # Terminal cases
-    zdd_zero = zdd_empty(mgr)
-    if f == zdd_zero
-        return g
-    end
-    if g == zdd_zero
-        return f
-    end
-    if f == g
-        return f
-    end
-
-    # Normalize: ensure f <= g for commutativity
-    if f > g
-        f, g = g, f
-    end
-
-    # Check cache
-    cached = cache_lookup(mgr, OP_ZDD_UNION, f, g, UInt64(0))
-    if cached != INVALID_NODE
-        return cached
-    end
-
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-
-    if f_level < g_level
-        # f has higher priority variable (appears first in ordering)
-        # g doesn't have this variable, so all sets in g go to else-branch
-        node_f = get_node(mgr, f)
-        t = node_f.then_child
-        e = zdd_union(mgr, node_f.else_child, g)
-        result = zdd_unique_lookup(mgr, Int(node_f.index), t, e)
-    elseif f_level > g_level
-        # g has higher priority variable (appears first in ordering)
-        # f doesn't have this variable, so all sets in f go to else-branch
-        node_g = get_node(mgr, g)
-        t = node_g.then_child
-        e = zdd_union(mgr, f, node_g.else_child)
-        result = zdd_unique_lookup(mgr, Int(node_g.index), t, e)
-    else
-        # Same variable
-        node_f = get_node(mgr, f)
-        node_g = get_node(mgr, g)
-        t = zdd_union(mgr, node_f.then_child, node_g.then_child)
-        e = zdd_union(mgr, node_f.else_child, node_g.else_child)
-        result = zdd_unique_lookup(mgr, Int(node_f.index), t, e)
-    end
-
-    # Cache result
-    cache_insert!(mgr, OP_ZDD_UNION, f, g, UInt64(0), result)
-    return result
+    return apply_op(mgr, ZddUnion(), f, g)
 end
 
 """
@@ -133,51 +62,7 @@ end
 Compute the intersection of two ZDD sets: f ∩ g
 """
 function zdd_intersection(mgr::DDManager, f::NodeId, g::NodeId)
-    # Terminal cases
-    zdd_zero = zdd_empty(mgr)
-    if f == zdd_zero || g == zdd_zero
-        return zdd_zero
-    end
-    if f == g
-        return f
-    end
-
-    # Normalize
-    if f > g
-        f, g = g, f
-    end
-
-    # Check cache
-    cached = cache_lookup(mgr, OP_ZDD_INTERSECT, f, g, UInt64(0))
-    if cached != INVALID_NODE
-        return cached
-    end
-
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-
-    if f_level < g_level
-        # f has higher priority variable, g doesn't have it
-        # For intersection, we only keep sets where both have the element
-        node_f = get_node(mgr, f)
-        result = zdd_intersection(mgr, node_f.else_child, g)
-    elseif f_level > g_level
-        # g has higher priority variable, f doesn't have it
-        node_g = get_node(mgr, g)
-        result = zdd_intersection(mgr, f, node_g.else_child)
-    else
-        # Same variable - both must have it or both must not have it
-        node_f = get_node(mgr, f)
-        node_g = get_node(mgr, g)
-        t = zdd_intersection(mgr, node_f.then_child, node_g.then_child)
-        e = zdd_intersection(mgr, node_f.else_child, node_g.else_child)
-        result = zdd_unique_lookup(mgr, Int(node_f.index), t, e)
-    end
-
-    # Cache result
-    cache_insert!(mgr, OP_ZDD_INTERSECT, f, g, UInt64(0), result)
-    return result
+    return apply_op(mgr, ZddIntersect(), f, g)
 end
 
 """
@@ -186,52 +71,7 @@ end
 Compute the set difference: f \\ g (elements in f but not in g)
 """
 function zdd_difference(mgr::DDManager, f::NodeId, g::NodeId)
-    # Terminal cases
-    zdd_zero = zdd_empty(mgr)
-    if f == zdd_zero
-        return zdd_zero
-    end
-    if g == zdd_zero
-        return f
-    end
-    if f == g
-        return zdd_zero
-    end
-
-    # Check cache
-    cached = cache_lookup(mgr, OP_ZDD_DIFF, f, g, UInt64(0))
-    if cached != INVALID_NODE
-        return cached
-    end
-
-    # Find top variable
-    f_level = node_level(mgr, f)
-    g_level = node_level(mgr, g)
-
-    if f_level < g_level
-        # f has higher priority variable
-        node_f = get_node(mgr, f)
-        t = zdd_difference(mgr, node_f.then_child, g)
-        e = zdd_difference(mgr, node_f.else_child, g)
-        result = zdd_unique_lookup(mgr, Int(node_f.index), t, e)
-    elseif f_level > g_level
-        # g has higher priority variable
-        node_g = get_node(mgr, g)
-        t = zdd_difference(mgr, f, node_g.then_child)
-        e = zdd_difference(mgr, f, node_g.else_child)
-        result = zdd_unique_lookup(mgr, Int(node_g.index), t, e)
-    else
-        # Same variable
-        node_f = get_node(mgr, f)
-        node_g = get_node(mgr, g)
-        t = zdd_difference(mgr, node_f.then_child, node_g.then_child)
-        e = zdd_difference(mgr, node_f.else_child, node_g.else_child)
-        result = zdd_unique_lookup(mgr, Int(node_f.index), t, e)
-    end
-
-    # Cache result
-    cache_insert!(mgr, OP_ZDD_DIFF, f, g, UInt64(0), result)
-    return result
+    return apply_op(mgr, ZddDiff(), f, g)
 end
 
 """
@@ -240,33 +80,7 @@ end
 Return the subset of f where var is present (positive cofactor).
 """
 function zdd_subset1(mgr::DDManager, f::NodeId, var::Int)
-    zdd_zero = zdd_empty(mgr)
-    zdd_one = zdd_base(mgr)
-    if f == zdd_zero
-        return zdd_zero
-    end
-    if f == zdd_one
-        return zdd_zero
-    end
-
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return zdd_zero
-    end
-
-    if node.index == var
-        # Return sets that contain var (then branch)
-        return node.then_child
-    elseif mgr.perm[node.index] < mgr.perm[var]
-        # Current variable is higher priority than var
-        # Recursively process both branches
-        t = zdd_subset1(mgr, node.then_child, var)
-        e = zdd_subset1(mgr, node.else_child, var)
-        return zdd_unique_lookup(mgr, Int(node.index), t, e)
-    else
-        # var is higher priority than current node, so var is not in any set
-        return zdd_zero
-    end
+    return apply_op_args(mgr, ZddSubset1(), f, var)
 end
 
 """
@@ -275,131 +89,238 @@ end
 Return the subset of f where var is absent (negative cofactor).
 """
 function zdd_subset0(mgr::DDManager, f::NodeId, var::Int)
-    zdd_zero = zdd_empty(mgr)
-    zdd_one = zdd_base(mgr)
-    if f == zdd_zero
-        return zdd_zero
-    end
-    if f == zdd_one
-        return zdd_one
+    return apply_op_args(mgr, ZddSubset0(), f, var)
+end
+
+"""
+    zdd_change(mgr::DDManager, f::NodeId, var::Int)
+
+Change operation: add var to sets not containing it, remove from sets containing it.
+"""
+function zdd_change(mgr::DDManager, f::NodeId, var::Int)
+    return apply_op_args(mgr, ZddChange(), f, var)
+end
+
+# The single-variable operators: the variable rides in the frames' g field
+struct ZddSubset0 <: ApplyOp end
+struct ZddSubset1 <: ApplyOp end
+struct ZddChange <: ApplyOp end
+
+@inline apply_tag(::ZddSubset0) = OP_ZDD_SUBSET0
+@inline apply_tag(::ZddSubset1) = OP_ZDD_SUBSET1
+@inline apply_tag(::ZddChange) = OP_ZDD_CHANGE
+@inline apply_build(mgr::DDManager, ::Union{ZddSubset0,ZddSubset1,ZddChange}, var::Int,
+                    t::NodeId, e::NodeId) = zdd_unique_lookup(mgr, var, t, e)
+
+# Recurse into both branches of a node above `var`
+@inline function zdd_var_step!(mgr::DDManager, op::ApplyOp, st::ApplyStacks, f::NodeId,
+                               var_arg::NodeId, index::Int)
+    cached = cache_lookup(mgr, apply_tag(op), f, var_arg, UInt64(0))
+    if cached != INVALID_NODE
+        return push_result!(st, cached)
     end
+    push_build!(st, f, var_arg, UInt64(0), index)
+    push_expand!(st, raw_else(mgr, f), var_arg)
+    push_expand!(st, raw_then(mgr, f), var_arg)
+end
 
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return f
+@inline function apply_step!(mgr::DDManager, op::ZddSubset1, st::ApplyStacks,
+                             f::NodeId, var_arg::NodeId, ::NodeId)
+    # No set of a terminal has var
+    if is_terminal(mgr, f)
+        return push_result!(st, zdd_empty(mgr))
     end
 
-    if node.index == var
-        # Return sets that don't contain var (else branch)
-        return node.else_child
-    elseif mgr.perm[node.index] < mgr.perm[var]
+    var = Int(var_arg)
+    index = Int(node_index(mgr, f))
+    if index == var
+        # Return sets that contain var (then branch)
+        return push_result!(st, raw_then(mgr, f))
+    elseif mgr.perm[index] < mgr.perm[var]
         # Current variable is higher priority than var
-        # Recursively process both branches
-        t = zdd_subset0(mgr, node.then_child, var)
-        e = zdd_subset0(mgr, node.else_child, var)
-        return zdd_unique_lookup(mgr, Int(node.index), t, e)
+        return zdd_var_step!(mgr, op, st, f, var_arg, index)
     else
         # var is higher priority than current node, so var is not in any set
-        return f
+        return push_result!(st, zdd_empty(mgr))
     end
 end
 
-"""
-    zdd_change(mgr::DDManager, f::NodeId, var::Int)
-
-Change operation: add var to sets not containing it, remove from sets containing it.
-"""
-function zdd_change(mgr::DDManager, f::NodeId, var::Int)
-    zdd_zero = zdd_empty(mgr)
-    zdd_one = zdd_base(mgr)
-    if f == zdd_zero
-        return zdd_zero
+@inline function apply_step!(mgr::DDManager, op::ZddSubset0, st::ApplyStacks,
+                             f::NodeId, var_arg::NodeId, ::NodeId)
+    if is_terminal(mgr, f)
+        return push_result!(st, f)
     end
-    if f == zdd_one
-        return zdd_singleton(mgr, var)
+
+    var = Int(var_arg)
+    index = Int(node_index(mgr, f))
+    if index == var
+        # Return sets that don't contain var (else branch)
+        return push_result!(st, raw_else(mgr, f))
+    elseif mgr.perm[index] < mgr.perm[var]
+        return zdd_var_step!(mgr, op, st, f, var_arg, index)
+    else
+        # var is higher priority than current node, so var is not in any set
+        return push_result!(st, f)
     end
+end
 
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return zdd_singleton(mgr, var)
+@inline function apply_step!(mgr::DDManager, op::ZddChange, st::ApplyStacks,
+                             f::NodeId, var_arg::NodeId, ::NodeId)
+    var = Int(var_arg)
+    if f == zdd_empty(mgr)
+        return push_result!(st, f)
+    end
+    if is_terminal(mgr, f)
+        return push_result!(st, zdd_singleton(mgr, var))
     end
 
-    if node.index == var
+    index = Int(node_index(mgr, f))
+    if index == var
         # Swap then and else children
-        return zdd_unique_lookup(mgr, var, node.else_child, node.then_child)
-    elseif mgr.perm[node.index] < mgr.perm[var]
-        t = zdd_change(mgr, node.then_child, var)
-        e = zdd_change(mgr, node.else_child, var)
-        return zdd_unique_lookup(mgr, Int(node.index), t, e)
+        return push_result!(st, zdd_unique_lookup(mgr, var, raw_else(mgr, f), raw_then(mgr, f)))
+    elseif mgr.perm[index] < mgr.perm[var]
+        return zdd_var_step!(mgr, op, st, f, var_arg, index)
     else
         # var is above this node
-        return zdd_unique_lookup(mgr, var, f, zdd_zero)
+        return push_result!(st, zdd_unique_lookup(mgr, var, f, zdd_empty(mgr)))
     end
 end
 
 """
     zdd_count(mgr::DDManager, f::NodeId)
+    zdd_count(::Type{T}, mgr::DDManager, f::NodeId)
 
 Count the number of sets (combinations) represented by the ZDD.
+
+The count is exact. It is computed in `UInt128` and only redone with
+`BigInt` if that overflows, which needs at least 128 variables. The second
+form counts in `T` instead, for example `Float64`. See
+[`zdd_log_count`](@ref) for huge families.
 """
 function zdd_count(mgr::DDManager, f::NodeId)
-    cache = Dict{NodeId, BigInt}()
-    return zdd_count_rec(mgr, f, cache)
+    try
+        return zdd_count(UInt128, mgr, f)
+    catch err
+        err isa OverflowError || rethrow()
+        return zdd_count(BigInt, mgr, f)
+    end
 end
 
-function zdd_count_rec(mgr::DDManager, f::NodeId, cache::Dict{NodeId, BigInt})
-    if haskey(cache, f)
-        return cache[f]
-    end
+zdd_count(::Type{T}, mgr::DDManager, f::NodeId) where {T<:Real} =
+    zdd_set_count(LinearCounts{T}(), mgr, f)
 
-    zdd_zero = zdd_empty(mgr)
-    zdd_one = zdd_base(mgr)
-    if f == zdd_zero
-        return BigInt(0)
-    end
-    if f == zdd_one
-        return BigInt(1)
-    end
+"""
+    zdd_log_count(mgr::DDManager, f::NodeId)
 
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return BigInt(0)
-    end
+Base-2 logarithm of [`zdd_count`](@ref), computed in log space; `-Inf` for
+the empty family.
+"""
+zdd_log_count(mgr::DDManager, f::NodeId) = zdd_set_count(Log2Counts(), mgr, f)
 
-    count_t = zdd_count_rec(mgr, node.then_child, cache)
-    count_e = zdd_count_rec(mgr, node.else_child, cache)
+@inline function zdd_edge_count(space, mgr::DDManager, counts::Vector, f::NodeId)
+    f == zdd_base(mgr) && return count_one(space)
+    is_terminal(mgr, f) && return count_zero(space)
+    return @inbounds counts[node_slot(f)]
+end
 
-    result = count_t + count_e
-    cache[f] = result
-    return result
+# Bottom-up over an array indexed by node slot: |f| = |f.then| + |f.else|
+function zdd_set_count(space, mgr::DDManager, f::NodeId)
+    store = mgr.nodes
+    counts = Vector{count_type(space)}(undef, length(store))
+    @inbounds for idx in bottom_up_slots(mgr, (f,))
+        t = zdd_edge_count(space, mgr, counts, store.then_child[idx])
+        e = zdd_edge_count(space, mgr, counts, store.else_child[idx])
+        counts[idx] = count_add(space, t, e)
+    end
+    return zdd_edge_count(space, mgr, counts, f)
 end
 
 """
-    zdd_from_sets(mgr::DDManager, sets::Vector{Vector{Int}})
+    zdd_from_sets(mgr::DDManager, sets; parallel::Bool = false)
 
 Create a ZDD from a collection of sets.
-Each set is represented as a vector of variable indices.
+Each set is represented as a vector of variable indices; duplicate sets and
+repeated elements are allowed.
+
+The ZDD is built bottom-up in one pass, without unions: the sets are turned
+into level lists and sorted, so the sets sharing the next variable form
+contiguous blocks that become the then-branches of the nodes. With
+`parallel = true`, on a manager created with `threaded = true`, the blocks
+of the top levels are built by separate tasks.
 """
-function zdd_from_sets(mgr::DDManager, sets::Vector{Vector{Int}})
-    zdd_zero = zdd_empty(mgr)
-    zdd_one = zdd_base(mgr)
-    result = zdd_zero
-
-    for set in sets
-        # Create ZDD for this single set
-        # Sort in ascending order and build from highest to lowest variable
-        sorted_set = sort(set)
-        set_zdd = zdd_one
-        for i in length(sorted_set):-1:1
-            var = sorted_set[i]
-            set_zdd = zdd_unique_lookup(mgr, var, set_zdd, zdd_zero)
+function zdd_from_sets(mgr::DDManager, sets::AbstractVector{<:AbstractVector{<:Integer}};
+                       parallel::Bool = false)
+    rows = Vector{Vector{Int}}(undef, length(sets))
+    for (k, set) in enumerate(sets)
+        for var in set
+            1 <= var <= mgr.num_vars ||
+                throw(ArgumentError("variable $var is out of range for a manager with $(mgr.num_vars) variables"))
         end
+        rows[k] = sort!(unique!([mgr.perm[var] for var in set]))
+    end
+    # Lexicographic by level, with a set that ends sorting after any longer one
+    sort!(rows; lt = (a, b) -> begin
+        for k in 1:min(length(a), length(b))
+            a[k] != b[k] && return a[k] < b[k]
+        end
+        return length(a) > length(b)
+    end)
 
-        # Union with result
-        result = zdd_union(mgr, result, set_zdd)
+    if parallel
+        depth = default_spawn_depth()
+        return run_parallel(() -> zdd_build_rec(mgr, rows, 1, length(rows), 1, depth), mgr)
     end
+    return zdd_build_rec(mgr, rows, 1, length(rows), 1, 0)
+end
 
-    return result
+# The block of rows[lo:hi] (lo <= hi, not ending before pos) whose level at
+# pos is the topmost one: that level and the block's last row
+@inline function zdd_block(rows::Vector{Vector{Int}}, lo::Int, hi::Int, pos::Int)
+    level = rows[lo][pos]
+    mid = lo
+    while mid < hi && length(rows[mid + 1]) >= pos && rows[mid + 1][pos] == level
+        mid += 1
+    end
+    return level, mid
+end
+
+# ZDD of rows[lo:hi] with their first pos-1 levels removed; the top `spawn`
+# levels fork tasks, the rest runs on an explicit stack
+function zdd_build_rec(mgr::DDManager, rows::Vector{Vector{Int}}, lo::Int, hi::Int,
+                       pos::Int, spawn::Int)
+    spawn > 0 || return zdd_build_seq(mgr, rows, lo, hi, pos)
+    lo > hi && return zdd_empty(mgr)
+    # Sets that end here sort last, so if the first one ends all of them do
+    length(rows[lo]) < pos && return zdd_base(mgr)
+
+    level, mid = zdd_block(rows, lo, hi, pos)
+    t, e = fork_join(() -> zdd_build_rec(mgr, rows, lo, mid, pos + 1, spawn - 1),
+                     () -> zdd_build_rec(mgr, rows, mid + 1, hi, pos, spawn - 1))
+    return zdd_unique_lookup(mgr, mgr.invperm[level], t, e)
+end
+
+function zdd_build_seq(mgr::DDManager, rows::Vector{Vector{Int}}, lo::Int, hi::Int, pos::Int)
+    # Frames (lo, hi, pos, var): var == 0 expands the block, var > 0 builds its
+    # node from the two topmost results
+    frames = [(lo, hi, pos, 0)]
+    results = NodeId[]
+    while !isempty(frames)
+        lo, hi, pos, var = pop!(frames)
+        if var > 0
+            e = pop!(results)
+            push!(results, zdd_unique_lookup(mgr, var, pop!(results), e))
+        elseif lo > hi
+            push!(results, zdd_empty(mgr))
+        elseif length(rows[lo]) < pos
+            push!(results, zdd_base(mgr))
+        else
+            level, mid = zdd_block(rows, lo, hi, pos)
+            push!(frames, (lo, hi, pos, mgr.invperm[level]))
+            push!(frames, (mid + 1, hi, pos, 0))
+            push!(frames, (lo, mid, pos + 1, 0))
+        end
+    end
+    return pop!(results)
 end
 
 """
@@ -407,37 +328,8 @@ end
 
 Extract all sets represented by a ZDD.
 Returns a vector of sets, where each set is a vector of variable indices.
+See [`zdd_sets`](@ref) to stream them instead.
 """
 function zdd_to_sets(mgr::DDManager, f::NodeId)
-    sets = Vector{Vector{Int}}()
-    current_set = Int[]
-    zdd_to_sets_rec(mgr, f, current_set, sets)
-    return sets
-end
-
-function zdd_to_sets_rec(mgr::DDManager, f::NodeId, current_set::Vector{Int},
-                         sets::Vector{Vector{Int}})
-    zdd_zero = zdd_empty(mgr)
-    zdd_one = zdd_base(mgr)
-    if f == zdd_zero
-        return
-    end
-
-    if f == zdd_one
-        push!(sets, copy(current_set))
-        return
-    end
-
-    node = get_node(mgr, f)
-    if is_terminal(node)
-        return
-    end
-
-    # Explore else-child (variable not in set)
-    zdd_to_sets_rec(mgr, node.else_child, current_set, sets)
-
-    # Explore then-child (variable in set)
-    push!(current_set, node.index)
-    zdd_to_sets_rec(mgr, node.then_child, current_set, sets)
-    pop!(current_set)
+    return [copy(set) for set in zdd_sets(mgr, f)]
 end
@@ -6,4 +6,8 @@ using AlgebraicDecisionDiagrams
     include("test_add.jl")
     include("test_zdd.jl")
     include("test_utils.jl")
+    include("test_reorder.jl")
+    include("test_parallel.jl")
+    include("test_serialize.jl")
+    include("test_cudd.jl")
 end
@@ -38,13 +38,13 @@
         result = add_plus(mgr, c1, c2)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
         @test AlgebraicDecisionDiagrams.is_terminal(node)
-        @test node.value == 10.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 10.0
 
         # Add with zero
         zero = add_const(mgr, 0.0)
         result = add_plus(mgr, c1, zero)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 3.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 3.0
     end
 
     @testset "ADD Subtraction" begin
@@ -55,7 +55,7 @@
 
         result = add_minus(mgr, c1, c2)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 7.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 7.0
     end
 
     @testset "ADD Multiplication" begin
@@ -66,19 +66,19 @@
 
         result = add_times(mgr, c1, c2)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 20.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 20.0
 
         # Multiply by zero
         zero = add_const(mgr, 0.0)
         result = add_times(mgr, c1, zero)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 0.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 0.0
 
         # Multiply by one
         one = add_const(mgr, 1.0)
         result = add_times(mgr, c1, one)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 4.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 4.0
     end
 
     @testset "ADD Division" begin
@@ -89,7 +89,7 @@
 
         result = add_divide(mgr, c1, c2)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 5.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 5.0
     end
 
     @testset "ADD Max/Min" begin
@@ -101,12 +101,12 @@
         # Max
         result = add_max(mgr, c1, c2)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 7.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 7.0
 
         # Min
         result = add_min(mgr, c1, c2)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 3.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 3.0
     end
 
     @testset "ADD Scalar Operations" begin
@@ -117,12 +117,12 @@
         # Scalar multiply
         result = add_scalar_multiply(mgr, c, 3.0)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == 15.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == 15.0
 
         # Negate
         result = add_negate(mgr, c)
         node = AlgebraicDecisionDiagrams.get_node(mgr, result)
-        @test node.value == -5.0
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, result) == -5.0
     end
 
     @testset "ADD with Variables" begin
@@ -244,4 +244,272 @@
         @test val3 == 2.0  # (0 + 1) * 2 = 2
         @test val4 == 4.0  # (1 + 1) * 2 = 4
     end
+
+    @testset "ADD Constant Table" begin
+        mgr = DDManager(2)
+
+        # Terminal 1 is shared with the BDD constant
+        @test add_const(mgr, 1.0) == mgr.one
+
+        # Many distinct constants stay unique and are found again
+        ids = [add_const(mgr, Float64(i)) for i in 1:2000]
+        @test length(unique(ids)) == 2000
+        @test all(add_const(mgr, Float64(i)) == ids[i] for i in 1:2000)
+
+        # Signed zeros are the same constant
+        @test add_const(mgr, -0.0) == add_const(mgr, 0.0)
+
+        # Tolerance mode merges nearby values
+        mgr2 = DDManager(2; epsilon = 1e-6)
+        c = add_const(mgr2, 0.5)
+        @test add_const(mgr2, 0.5 + 1e-8) == c
+        @test add_const(mgr2, 0.5 - 1e-8) == c
+        @test add_const(mgr2, 0.6) != c
+
+        set_epsilon!(mgr, 0.1)
+        @test add_const(mgr, 3.05) == ids[3]
+
+        # Integer constants are compared without wrapping around
+        @test !AlgebraicDecisionDiagrams.within_epsilon(Int32(-1), typemax(Int32), 1.5)
+        imgr = DDManager{Int32}(2; epsilon = 1.5)
+        @test add_const(imgr, typemin(Int32) + 1) == add_const(imgr, typemin(Int32))
+        @test add_const(imgr, -1) != add_const(imgr, typemax(Int32))
+        @test_throws ArgumentError set_epsilon!(mgr, -1.0)
+    end
+
+    @testset "ADD Operator Tags" begin
+        mgr = DDManager(3)
+        x1 = add_ith_var(mgr, 1)
+        x2 = add_ith_var(mgr, 2)
+
+        # Built-in operators have fixed, distinct tags
+        tags = [AlgebraicDecisionDiagrams.add_op_tag(mgr, op) for op in (+, -, *, /, max, min)]
+        @test allunique(tags)
+        @test all(t -> t < AlgebraicDecisionDiagrams.OP_USER_BASE, tags)
+
+        # User operators get stable tags of their own
+        hypot2 = (a, b) -> a * a + b * b
+        absdiff = (a, b) -> abs(a - b)
+        t1 = register_add_op!(mgr, hypot2)
+        @test register_add_op!(mgr, hypot2) == t1
+        @test register_add_op!(mgr, absdiff) != t1
+        @test t1 >= AlgebraicDecisionDiagrams.OP_USER_BASE
+
+        # Same operands, different operators: cached results must not alias
+        f = add_plus(mgr, x1, x2)
+        g = add_scalar_multiply(mgr, x2, 3.0)
+        r1 = add_apply(mgr, hypot2, f, g)
+        r2 = add_apply(mgr, absdiff, f, g)
+        @test r1 != r2
+        for a in (false, true), b in (false, true)
+            env = Dict(1 => a, 2 => b)
+            fv = add_eval(mgr, f, env)
+            gv = add_eval(mgr, g, env)
+            @test add_eval(mgr, r1, env) == fv * fv + gv * gv
+            @test add_eval(mgr, r2, env) == abs(fv - gv)
+        end
+        @test add_apply(mgr, hypot2, f, g) == r1
+    end
+
+    @testset "ADD Batch Evaluation" begin
+        mgr = DDManager(4)
+        x = [add_ith_var(mgr, i) for i in 1:4]
+        # 3*x1 + 2*x2*x4 - x3
+        f = add_plus(mgr, add_scalar_multiply(mgr, x[1], 3.0),
+                     add_minus(mgr, add_scalar_multiply(mgr, add_times(mgr, x[2], x[4]), 2.0), x[3]))
+
+        X = falses(16, 4)
+        for r in 1:16, i in 1:4
+            X[r, i] = ((r - 1) >> (i - 1)) & 1 == 1
+        end
+        expected = [add_eval(mgr, f, Dict(i => X[r, i] for i in 1:4)) for r in 1:16]
+
+        @test add_eval_batch(mgr, f, X) == expected
+        @test add_eval_batch(mgr, f, Matrix{Bool}(X)) == expected
+
+        cf = compile_add(mgr, f)
+        @test cf.num_vars == 4
+        @test add_eval_batch(cf, X; threaded = true) == expected
+        out = zeros(16)
+        @test add_eval_batch!(out, cf, X) === out
+        @test out == expected
+
+        # Survives garbage collection of the diagram it was compiled from
+        garbage_collect!(mgr)
+        @test add_eval_batch(cf, X) == expected
+
+        # Constants need no columns
+        c = compile_add(mgr, add_const(mgr, 7.5))
+        @test add_eval_batch(c, falses(3, 0)) == [7.5, 7.5, 7.5]
+
+        @test_throws DimensionMismatch add_eval_batch(cf, falses(2, 3))
+        @test_throws DimensionMismatch add_eval_batch!(zeros(3), cf, X)
+    end
+
+    @testset "ADD Terminal Fast Paths" begin
+        mgr = DDManager(3)
+        x = [add_ith_var(mgr, i) for i in 1:3]
+        f = add_plus(mgr, add_times(mgr, x[1], x[2]), add_scalar_multiply(mgr, x[3], 2.0))
+        zero = add_const(mgr, 0.0)
+        one = add_const(mgr, 1.0)
+
+        # The shared constants live in the manager and carry the terminal tag
+        @test zero == mgr.add_zero
+        @test one == mgr.one
+        @test AlgebraicDecisionDiagrams.is_terminal_id(zero)
+        @test !AlgebraicDecisionDiagrams.is_terminal_id(f)
+        @test AlgebraicDecisionDiagrams.is_terminal(mgr, add_const(mgr, 3.5))
+
+        # Identities are resolved from the ids, without the computed table
+        reset_cache_stats!(mgr)
+        @test add_plus(mgr, f, zero) == f
+        @test add_plus(mgr, zero, f) == f
+        @test add_minus(mgr, f, zero) == f
+        @test add_minus(mgr, f, f) == zero
+        @test add_times(mgr, f, one) == f
+        @test add_times(mgr, zero, f) == zero
+        @test add_divide(mgr, f, one) == f
+        @test add_max(mgr, f, f) == f
+        @test add_min(mgr, f, f) == f
+        @test isempty(cache_stats(mgr))
+
+        # Constant folding still applies to other terminals
+        @test add_plus(mgr, add_const(mgr, 1.5), add_const(mgr, 2.0)) == add_const(mgr, 3.5)
+    end
+
+    @testset "Manager Construction" begin
+        for T in (Float64, Float32, Int32)
+            mgr = DDManager{T}(4)
+            @test eltype(mgr.values) == T
+            @test AlgebraicDecisionDiagrams.terminal_value(mgr, mgr.one) === one(T)
+            @test AlgebraicDecisionDiagrams.terminal_value(mgr, mgr.add_zero) === zero(T)
+            @test mgr.add_zero != mgr.one && mgr.add_zero != mgr.zero
+            @test length(mgr.vars) == 4
+        end
+        @test DDManager{Int32}(0).num_vars == 0
+    end
+
+    @testset "Typed ADD Managers" begin
+        mgr = DDManager{Int32}(3)
+        @test mgr isa DDManager{Int32}
+        @test eltype(mgr.values) == Int32
+        @test DDManager(3) isa DDManager{Float64}
+
+        x = [add_ith_var(mgr, i) for i in 1:3]
+        f = add_plus(mgr, add_plus(mgr, x[1], add_scalar_multiply(mgr, x[2], 3)),
+                     add_scalar_multiply(mgr, x[3], -2))
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, add_plus(mgr, add_const(mgr, 2), add_const(mgr, 5))) === Int32(7)
+        @test add_const(mgr, 7) == add_const(mgr, 7.0)
+        @test add_find_max(mgr, f) === Int32(4)
+        @test add_find_min(mgr, f) === Int32(-2)
+        @test add_eval(mgr, f, Dict(1 => true, 2 => true, 3 => false)) === Int32(4)
+        @test add_threshold(mgr, f, 3) == bdd_and(mgr, ith_var(mgr, 2), bdd_not(mgr, ith_var(mgr, 3)))
+        @test_throws InexactError add_const(mgr, 0.5)
+
+        X = BitMatrix([1 1 1; 0 1 0; 0 0 1])
+        cf = compile_add(mgr, f)
+        @test cf isa CompiledADD{Int32}
+        @test add_eval_batch(cf, X) == Int32[2, 3, -2]
+        @test eltype(add_eval_batch(mgr, f, X)) == Int32
+
+        # Smaller floats keep their own precision
+        mgr32 = DDManager{Float32}(2)
+        g = add_plus(mgr32, add_ith_var(mgr32, 1), add_const(mgr32, 0.1f0))
+        @test add_find_max(mgr32, g) === 1.1f0
+        @test add_eval_batch(compile_add(mgr32, g), BitMatrix([1 0; 0 0])) == Float32[1.1f0, 0.1f0]
+
+        # BDD and ZDD operations do not depend on the value type
+        h = bdd_or(mgr, ith_var(mgr, 1), ith_var(mgr, 2))
+        @test count_minterms(mgr, h, 3) == 6
+        @test zdd_count(mgr, zdd_union(mgr, zdd_singleton(mgr, 1), zdd_singleton(mgr, 2))) == 2
+
+        # Files carry Float64 values and load into a typed manager
+        buf = IOBuffer()
+        save_dd(buf, mgr, f)
+        other = DDManager{Int32}(3)
+        g = load_dd(other, take!(buf))
+        @test add_find_max(other, g) === Int32(4)
+        @test add_eval_batch(compile_add(other, g), X) == Int32[2, 3, -2]
+    end
+
+    @testset "ADD Abstraction" begin
+        mgr = DDManager(6)
+        x = [add_ith_var(mgr, i) for i in 1:6]
+        f = add_plus(mgr, add_times(mgr, x[1], add_scalar_multiply(mgr, x[2], 3.0)),
+                     add_plus(mgr, add_scalar_multiply(mgr, x[4], 2.0),
+                              add_max(mgr, x[5], add_const(mgr, 0.5))))
+
+        # One variable at a time with restrict, for reference
+        naive(op, f, vars) = foldl((g, v) -> add_apply(mgr, op, add_restrict(mgr, g, v, false),
+                                                       add_restrict(mgr, g, v, true)), vars; init = f)
+
+        vars = [2, 4, 5, 6]
+        @test add_exist_abstract(mgr, f, vars) == naive(+, f, vars)
+        @test add_univ_abstract(mgr, f, vars) == naive(*, f, vars)
+        @test add_max_abstract(mgr, f, vars) == naive(max, f, vars)
+        @test add_min_abstract(mgr, f, vars) == naive(min, f, vars)
+        @test add_exist_abstract(mgr, f, bdd_cube(mgr, vars)) == add_exist_abstract(mgr, f, vars)
+        @test add_exist_abstract(mgr, f, Int[]) == f
+
+        # A variable f does not test doubles a sum and squares a product
+        @test add_exist_abstract(mgr, f, [3]) == add_scalar_multiply(mgr, f, 2.0)
+        @test add_univ_abstract(mgr, add_const(mgr, 3.0), [3, 6]) == add_const(mgr, 81.0)
+        @test add_max_abstract(mgr, f, collect(1:6)) == add_const(mgr, add_find_max(mgr, f))
+        @test add_min_abstract(mgr, f, collect(1:6)) == add_const(mgr, add_find_min(mgr, f))
+        @test any(s -> s.op == "ADD_EXIST_ABS", cache_stats(mgr))
+
+        # Matrix product: sum over z of A[x, z] * B[z, y]
+        A = add_plus(mgr, x[1], x[2])
+        B = add_times(mgr, x[2], x[3])
+        C = add_matrix_multiply(mgr, A, B, [2])
+        @test C == add_times(mgr, add_plus(mgr, x[1], mgr.one), x[3])
+        @test C == add_exist_abstract(mgr, add_times(mgr, A, B), [2])
+
+        g = add_plus(mgr, add_scalar_multiply(mgr, x[4], 5.0), add_times(mgr, x[3], x[6]))
+        for z in ([3], [3, 4], [1, 3, 5], Int[])
+            @test add_matrix_multiply(mgr, f, g, z) == add_exist_abstract(mgr, add_times(mgr, f, g), z)
+        end
+        @test add_matrix_multiply(mgr, f, g, bdd_cube(mgr, [3, 4])) ==
+              add_matrix_multiply(mgr, g, f, [3, 4])
+        @test any(s -> s.op == "ADD_MATMUL", cache_stats(mgr))
+
+        # Typed managers sum in their own type
+        imgr = DDManager{Int32}(2)
+        h = add_plus(imgr, add_ith_var(imgr, 1), add_scalar_multiply(imgr, add_ith_var(imgr, 2), 4))
+        @test AlgebraicDecisionDiagrams.terminal_value(imgr, add_exist_abstract(imgr, h, [1, 2])) === Int32(10)
+    end
+
+    @testset "ADD Permute" begin
+        mgr = DDManager(6)
+        x = [add_ith_var(mgr, i) for i in 1:6]
+        build(v) = add_plus(mgr, add_plus(mgr, v[1], add_scalar_multiply(mgr, v[2], 2.0)),
+                            add_scalar_multiply(mgr, add_times(mgr, v[3], v[5]), 4.0))
+        f = build(x)
+
+        @test add_permute(mgr, f, [2, 1, 4, 3, 6, 5]) == build(x[[2, 1, 4, 3, 6, 5]])
+        @test add_permute(mgr, f, 1:6) == f
+        reset_cache_stats!(mgr)
+        @test add_permute(mgr, f, 6:-1:1) == build(x[6:-1:1])
+        @test any(s -> s.op == "ADD_VAR_ITE", cache_stats(mgr))
+        @test add_permute(mgr, add_const(mgr, 2.5), 6:-1:1) == add_const(mgr, 2.5)
+        @test_throws ArgumentError add_permute(mgr, f, [1, 2])
+    end
+
+    @testset "Deep ADD Abstraction On A Small Stack" begin
+        function deep_results(n)
+            mgr = DDManager(n)
+            product(vars) = foldl((acc, i) -> add_times(mgr, add_ith_var(mgr, i), acc), reverse(vars);
+                                  init = add_const(mgr, 1.0))
+            a_all, a_head = product(collect(1:n)), product(collect(1:n-1))
+            return [add_exist_abstract(mgr, a_all, [n]) == a_head,
+                    add_max_abstract(mgr, add_const(mgr, 3.0), collect(1:n)) == add_const(mgr, 3.0),
+                    add_matrix_multiply(mgr, a_all, add_ith_var(mgr, n), [n]) == a_head,
+                    AlgebraicDecisionDiagrams.add_var_ite(mgr, n, a_head, add_const(mgr, 0.0)) == a_all]
+        end
+
+        @test all(deep_results(8))
+        task = Task(() -> deep_results(20_000), 1 << 19)
+        schedule(task)
+        @test all(fetch(task))
+    end
 end
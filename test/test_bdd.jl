@@ -198,4 +198,268 @@
         f = bdd_and(mgr, x1, x2)
         @test count_nodes(mgr, f) >= 2
     end
+
+    @testset "BDD Relational Product" begin
+        mgr = DDManager(6)
+        x = [ith_var(mgr, i) for i in 1:6]
+
+        # One variable at a time through cofactors, as a reference
+        exists_seq(f, vars) = foldl(vars; init = f) do acc, v
+            bdd_or(mgr, bdd_restrict(mgr, acc, v, false), bdd_restrict(mgr, acc, v, true))
+        end
+
+        # T relates (x1, x2, x3) to (x4, x5, x6); S is a set over x1..x3
+        t = mgr.one
+        for i in 1:3
+            t = bdd_and(mgr, t, bdd_xor(mgr, x[i + 3], bdd_or(mgr, x[i], x[mod1(i + 1, 3)])))
+        end
+        s = bdd_or(mgr, bdd_and(mgr, x[1], bdd_not(mgr, x[2])), x[3])
+
+        vars = [3, 1, 2]
+        cube = bdd_cube(mgr, vars)
+        @test cube == bdd_and(mgr, x[1], bdd_and(mgr, x[2], x[3]))
+        @test bdd_cube(mgr, Int[]) == mgr.one
+
+        image = bdd_and_exists(mgr, t, s, cube)
+        @test image == exists_seq(bdd_and(mgr, t, s), vars)
+        @test image == bdd_exists(mgr, bdd_and(mgr, t, s), vars)
+        @test bdd_and_exists(mgr, s, t, vars) == image
+        @test bdd_and_exists(mgr, t, s, mgr.one) == bdd_and(mgr, t, s)
+
+        # Universal quantification is the dual
+        g = bdd_or(mgr, t, s)
+        @test bdd_forall(mgr, g, cube) ==
+              bdd_not(mgr, exists_seq(bdd_not(mgr, g), vars))
+
+        # Complement edges are canonical: equal functions get equal ids
+        @test bdd_or(mgr, x[1], x[2]) ==
+              bdd_not(mgr, bdd_and(mgr, bdd_not(mgr, x[1]), bdd_not(mgr, x[2])))
+        @test bdd_ite(mgr, x[1], bdd_not(mgr, x[2]), x[2]) == bdd_xor(mgr, x[1], x[2])
+    end
+
+    @testset "Deep Apply" begin
+        # x1 ∧ x3 ∧ ... and x2 ∧ x4 ∧ ... interleave, so their conjunction
+        # descends through every level
+        n = 10000
+        mgr = DDManager(n)
+        chain(vars) = foldl((acc, i) -> bdd_and(mgr, ith_var(mgr, i), acc), reverse(vars);
+                            init = mgr.one)
+        odd = chain(collect(1:2:n))
+        even = chain(collect(2:2:n))
+        all_vars = chain(collect(1:n))
+
+        @test bdd_and(mgr, odd, even) == all_vars
+        @test bdd_ite(mgr, odd, even, mgr.zero) == all_vars
+        @test bdd_or(mgr, bdd_not(mgr, odd), bdd_not(mgr, even)) == bdd_not(mgr, all_vars)
+        @test bdd_xor(mgr, all_vars, all_vars) == mgr.zero
+        @test isempty(mgr.apply_stacks.frames) && isempty(mgr.apply_stacks.results)
+    end
+
+    @testset "Deep Operators On A Small Stack" begin
+        # Every operator below descends through all levels of a chain; a task
+        # with this stack would not hold one Julia frame per level
+        function deep_results(n)
+            mgr = DDManager(n)
+            chain(vars) = foldl((acc, i) -> bdd_and(mgr, ith_var(mgr, i), acc), reverse(vars);
+                                init = mgr.one)
+            all_vars, head = chain(collect(1:n)), chain(collect(1:n-1))
+            odd, even = chain(collect(1:2:n)), chain(collect(2:2:n))
+            product(vars) = foldl((acc, i) -> add_times(mgr, add_ith_var(mgr, i), acc), reverse(vars);
+                                  init = add_const(mgr, 1.0))
+            a_all, a_head = product(collect(1:n)), product(collect(1:n-1))
+
+            zmgr = DDManager(n)
+            full = foldl((acc, i) -> zdd_change(zmgr, acc, i), n:-1:1; init = zdd_base(zmgr))
+            singles(vars) = foldl((acc, i) -> zdd_union(zmgr, zdd_singleton(zmgr, i), acc), vars;
+                                  init = zdd_empty(zmgr))
+
+            return [bdd_exists(mgr, all_vars, [n]) == head,
+                    bdd_forall(mgr, bdd_not(mgr, all_vars), [n]) == bdd_not(mgr, head),
+                    bdd_and_exists(mgr, odd, even, [n]) == head,
+                    bdd_restrict(mgr, all_vars, n, true) == head,
+                    bdd_restrict(mgr, bdd_not(mgr, all_vars), n, false) == mgr.one,
+                    count_nodes(mgr, all_vars) == n,
+                    add_restrict(mgr, a_all, n, true) == a_head,
+                    add_restrict(mgr, a_all, n, false) == add_const(mgr, 0.0),
+                    zdd_subset1(zmgr, full, n) == full,
+                    zdd_subset0(zmgr, full, n) == zdd_empty(zmgr),
+                    zdd_change(zmgr, zdd_change(zmgr, full, n), n) == full,
+                    zdd_subset0(zmgr, singles(n:-1:1), n) == singles(n-1:-1:1),
+                    zdd_from_sets(zmgr, [collect(1:n)]) == full,
+                    zdd_from_sets(zmgr, [[i] for i in 1:n]) == singles(n:-1:1)]
+        end
+
+        # Compile on the main task, then run deep on a 512 KiB stack
+        @test all(deep_results(8))
+        task = Task(() -> deep_results(20_000), 1 << 19)
+        schedule(task)
+        @test all(fetch(task))
+    end
+
+    @testset "BDD Cube and Minterm Iterators" begin
+        mgr = DDManager(4)
+        x = [ith_var(mgr, i) for i in 1:4]
+        f = bdd_or(mgr, bdd_and(mgr, x[1], bdd_not(mgr, x[3])), bdd_xor(mgr, x[2], x[4]))
+
+        # Cubes are disjoint and cover exactly the minterms of f
+        cubes = [copy(c) for c in bdd_cubes(mgr, f)]
+        @test sum(c -> 2^count(==(2), c), cubes) == count_minterms(mgr, f, 4)
+        for c in cubes
+            cube = mgr.one
+            for (v, lit) in enumerate(c)
+                lit == 1 && (cube = bdd_and(mgr, cube, x[v]))
+                lit == 0 && (cube = bdd_and(mgr, cube, bdd_not(mgr, x[v])))
+            end
+            @test bdd_and(mgr, cube, f) == cube
+        end
+
+        minterms = [copy(m) for m in bdd_minterms(mgr, f)]
+        @test length(minterms) == count_minterms(mgr, f, 4)
+        @test allunique(minterms)
+        @test all(minterms) do m
+            (m[1] && !m[3]) || (m[2] ⊻ m[4])
+        end
+
+        # Terminals and laziness
+        @test isempty(collect(bdd_cubes(mgr, mgr.zero)))
+        @test [copy(c) for c in bdd_cubes(mgr, mgr.one)] == [fill(Int8(2), 4)]
+        @test length(collect(bdd_minterms(mgr, mgr.one))) == 16
+        @test length(collect(Iterators.take(bdd_minterms(mgr, mgr.one), 5))) == 5
+        @test [copy(c) for c in bdd_cubes(mgr, bdd_not(mgr, x[2]))] == [Int8[2, 0, 2, 2]]
+    end
+
+    @testset "BDD Bulk Construction" begin
+        mgr = DDManager(4)
+        x = [ith_var(mgr, i) for i in 1:4]
+        f = bdd_or(mgr, bdd_and(mgr, x[1], bdd_not(mgr, x[3])), bdd_xor(mgr, x[2], x[4]))
+
+        # Truth table: vars[1] is the least significant bit of the index
+        table = [((i >> 0) & 1 == 1 && (i >> 2) & 1 == 0) || (((i >> 1) & 1) ⊻ ((i >> 3) & 1) == 1)
+                 for i in 0:15]
+        @test bdd_from_truth_table(mgr, table) == f
+        @test bdd_from_truth_table(mgr, [false, true], [3]) == x[3]
+        @test bdd_from_truth_table(mgr, [false, false, false, true], [4, 2]) == bdd_and(mgr, x[2], x[4])
+        @test_throws ArgumentError bdd_from_truth_table(mgr, [true, false, true])
+        @test_throws ArgumentError bdd_from_truth_table(mgr, [true, false], [5])
+
+        # Cube lists, including the cubes of an existing function
+        @test bdd_from_cubes(mgr, [copy(c) for c in bdd_cubes(mgr, f)]) == f
+        @test bdd_from_cubes(mgr, Vector{Int8}[]) == mgr.zero
+        @test bdd_from_cubes(mgr, [[2, 2, 2, 2]]) == mgr.one
+        @test bdd_from_cubes(mgr, [[1, 2, 0], [2, 1]]) ==
+              bdd_or(mgr, bdd_and(mgr, x[1], bdd_not(mgr, x[3])), x[2])
+
+        # Independent of the variable order
+        mgr2 = AlgebraicDecisionDiagrams.set_initial_order!(DDManager(4), [3, 1, 4, 2])
+        y = [ith_var(mgr2, i) for i in 1:4]
+        g = bdd_or(mgr2, bdd_and(mgr2, y[1], bdd_not(mgr2, y[3])), bdd_xor(mgr2, y[2], y[4]))
+        @test bdd_from_truth_table(mgr2, table) == g
+        @test bdd_from_cubes(mgr2, [copy(c) for c in bdd_cubes(mgr, f)]) == g
+    end
+
+    @testset "BDD Vector Compose and Permute" begin
+        mgr = DDManager(6)
+        x = [ith_var(mgr, i) for i in 1:6]
+        build(v) = bdd_or(mgr, bdd_or(mgr, bdd_and(mgr, v[1], v[2]), bdd_xor(mgr, v[3], v[4])),
+                          bdd_not(mgr, v[5]))
+        f = build(x)
+
+        # Renamings that keep the order and ones that do not
+        swap = [2, 1, 4, 3, 6, 5]
+        @test bdd_permute(mgr, f, swap) == build(x[swap])
+        @test bdd_permute(mgr, f, 6:-1:1) == build(x[6:-1:1])
+        @test bdd_permute(mgr, f, 1:6) == f
+        @test bdd_permute(mgr, bdd_not(mgr, f), swap) == bdd_not(mgr, bdd_permute(mgr, f, swap))
+        shift = [2, 3, 4, 5, 6, 1]
+        @test bdd_permute(mgr, bdd_permute(mgr, f, shift), invperm(shift)) == f
+
+        # Substitutions are simultaneous
+        @test bdd_vector_compose(mgr, f, x[swap]) == bdd_permute(mgr, f, swap)
+        vector = copy(x)
+        vector[1] = bdd_and(mgr, x[3], x[6])
+        vector[3] = bdd_not(mgr, x[1])
+        @test bdd_vector_compose(mgr, f, vector) == build(vector)
+        @test bdd_vector_compose(mgr, f, x) == f
+
+        # Constants restrict
+        vector = copy(x)
+        vector[5] = mgr.one
+        @test bdd_vector_compose(mgr, f, vector) == bdd_restrict(mgr, f, 5, true)
+        @test bdd_vector_compose(mgr, mgr.one, vector) == mgr.one
+
+        @test_throws ArgumentError bdd_permute(mgr, f, [1, 1, 2, 3, 4, 5])
+        @test_throws ArgumentError bdd_permute(mgr, f, [1, 2, 3])
+        @test_throws ArgumentError bdd_vector_compose(mgr, f, x[1:5])
+    end
+
+    @testset "BDD Don't-Care Minimization" begin
+        mgr = DDManager(6)
+        x = [ith_var(mgr, i) for i in 1:6]
+        leq(f, g) = bdd_and(mgr, f, bdd_not(mgr, g)) == mgr.zero
+        fs = [bdd_or(mgr, bdd_and(mgr, x[1], x[2]), bdd_and(mgr, bdd_not(mgr, x[1]), x[3])),
+              bdd_xor(mgr, bdd_xor(mgr, x[2], x[4]), bdd_and(mgr, x[5], x[6])),
+              bdd_or(mgr, bdd_and(mgr, x[1], x[6]), bdd_not(mgr, bdd_and(mgr, x[3], x[4])))]
+        cs = [x[1], bdd_and(mgr, x[2], x[3]), bdd_or(mgr, bdd_xor(mgr, x[1], x[4]), x[6]),
+              bdd_not(mgr, bdd_and(mgr, x[2], x[5]))]
+
+        # Every minimizer agrees with f on the care set
+        for f in fs, c in cs
+            for g in (bdd_constrain(mgr, f, c), bdd_restrict(mgr, f, c), bdd_li_compaction(mgr, f, c))
+                @test bdd_and(mgr, g, c) == bdd_and(mgr, f, c)
+            end
+            @test count_nodes(mgr, bdd_restrict(mgr, f, c)) <= count_nodes(mgr, f)
+            @test count_nodes(mgr, bdd_li_compaction(mgr, f, c)) <= count_nodes(mgr, f)
+
+            l, u = bdd_and(mgr, f, c), bdd_or(mgr, f, bdd_not(mgr, c))
+            g = bdd_squeeze(mgr, l, u)
+            @test leq(l, g) && leq(g, u)
+            @test count_nodes(mgr, g) <= min(count_nodes(mgr, l), count_nodes(mgr, u))
+        end
+
+        f, g = fs[1], fs[2]
+        c = cs[3]
+        @test bdd_constrain(mgr, bdd_and(mgr, f, g), c) ==
+              bdd_and(mgr, bdd_constrain(mgr, f, c), bdd_constrain(mgr, g, c))
+        @test bdd_constrain(mgr, bdd_not(mgr, f), c) == bdd_not(mgr, bdd_constrain(mgr, f, c))
+        @test bdd_constrain(mgr, f, bdd_and(mgr, x[1], bdd_not(mgr, x[3]))) ==
+              bdd_restrict(mgr, bdd_restrict(mgr, f, 1, true), 3, false)
+        @test bdd_constrain(mgr, f, mgr.one) == f
+        @test bdd_constrain(mgr, f, mgr.zero) == mgr.zero
+        @test bdd_constrain(mgr, c, c) == mgr.one
+        @test any(s -> s.op == "CONSTRAIN", cache_stats(mgr))
+
+        # Restrict drops care-set variables f does not test
+        @test bdd_restrict(mgr, g, x[1]) == g
+        @test bdd_restrict(mgr, f, x[1]) == x[2]
+
+        # Compaction removes the nodes whose edges the care set never takes
+        @test bdd_li_compaction(mgr, f, x[1]) == x[2]
+        @test bdd_li_compaction(mgr, f, bdd_and(mgr, x[2], x[3])) == mgr.one
+
+        g = bdd_squeeze(mgr, bdd_and(mgr, x[1], x[2]), bdd_or(mgr, x[1], x[2]))
+        @test g == x[1] || g == x[2]
+        @test bdd_squeeze(mgr, f, f) == f
+        @test_throws ArgumentError bdd_squeeze(mgr, x[1], x[2])
+    end
+
+    @testset "Deep Minimization On A Small Stack" begin
+        function deep_results(n)
+            mgr = DDManager(n)
+            chain(vars) = foldl((acc, i) -> bdd_and(mgr, ith_var(mgr, i), acc), reverse(vars);
+                                init = mgr.one)
+            all_vars, head = chain(collect(1:n)), chain(collect(1:n-1))
+            last = ith_var(mgr, n)
+            # On the care set head, all_vars is just its last variable
+            return [bdd_constrain(mgr, all_vars, head) == last,
+                    bdd_constrain(mgr, bdd_not(mgr, all_vars), head) == bdd_not(mgr, last),
+                    bdd_restrict(mgr, all_vars, head) == last,
+                    bdd_li_compaction(mgr, all_vars, head) == last,
+                    bdd_squeeze(mgr, all_vars, head) == head]
+        end
+
+        @test all(deep_results(8))
+        task = Task(() -> deep_results(20_000), 1 << 19)
+        schedule(task)
+        @test all(fetch(task))
+    end
 end
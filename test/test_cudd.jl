@@ -0,0 +1,145 @@
+@testset "CUDD Backend" begin
+    if !cudd_available()
+        @info "CUDD library not found at $(cudd_library()); skipping the CUDD backend tests"
+        @test_skip cudd_available()
+    else
+        # The same code on both backends must describe the same functions
+        function circuit(mgr)
+            x = [ith_var(mgr, i) for i in 1:6]
+            f = bdd_or(mgr, bdd_and(mgr, x[1], x[2]), bdd_xor(mgr, x[3], bdd_not(mgr, x[4])))
+            g = bdd_ite(mgr, x[5], f, bdd_and(mgr, x[6], x[1]))
+            return x, f, g
+        end
+
+        @testset "BDD Operations" begin
+            native, cudd = DDManager(6), CuddManager(6)
+            xn, fn, gn = circuit(native)
+            xc, fc, gc = circuit(cudd)
+            for (a, b) in ((fn, fc), (gn, gc))
+                @test count_nodes(native, a) == count_nodes(cudd, b)
+                @test count_minterms(native, a, 6) == count_minterms(cudd, b, 6)
+            end
+            @test count_minterms(native, bdd_exists(native, gn, [1, 5]), 6) ==
+                  count_minterms(cudd, bdd_exists(cudd, gc, [1, 5]), 6)
+            @test count_minterms(native, bdd_and_exists(native, fn, gn, [3]), 6) ==
+                  count_minterms(cudd, bdd_and_exists(cudd, fc, gc, [3]), 6)
+            @test count_minterms(native, bdd_restrict(native, gn, 5, false), 6) ==
+                  count_minterms(cudd, bdd_restrict(cudd, gc, 5, false), 6)
+            permut = [6, 5, 4, 3, 2, 1]
+            @test count_nodes(native, bdd_permute(native, gn, permut)) ==
+                  count_nodes(cudd, bdd_permute(cudd, gc, permut))
+            @test bdd_and(cudd, gc, bdd_not(cudd, gc)) == cudd.zero
+            @test_throws ArgumentError ith_var(cudd, 7)
+
+            # Don't-care minimization keeps f on the care set
+            r = bdd_restrict(cudd, gc, fc)
+            @test bdd_and(cudd, bdd_xor(cudd, r, gc), fc) == cudd.zero
+            close(cudd)
+        end
+
+        @testset "ADD Operations" begin
+            native, cudd = DDManager(4), CuddManager(4)
+            build(mgr) = add_plus(mgr, add_scalar_multiply(mgr, add_ith_var(mgr, 1), 2.0),
+                                  add_max(mgr, add_ith_var(mgr, 2), add_const(mgr, 0.5)))
+            fn, fc = build(native), build(cudd)
+            @test count_nodes(native, fn) == count_nodes(cudd, fc)
+            for bits in 0:3
+                assignment = Dict(1 => isodd(bits), 2 => bits >= 2)
+                @test add_eval(native, fn, assignment) == add_eval(cudd, fc, assignment)
+            end
+            @test add_find_max(cudd, fc) == 3.0
+            @test add_find_min(cudd, fc) == 0.5
+            @test add_eval(cudd, add_exist_abstract(cudd, fc, [1, 2]), Dict{Int,Bool}()) ==
+                  add_eval(native, add_exist_abstract(native, fn, [1, 2]), Dict{Int,Bool}())
+            @test count_minterms(cudd, add_threshold(cudd, fc, 1.0), 4) ==
+                  count_minterms(native, add_threshold(native, fn, 1.0), 4)
+            close(cudd)
+        end
+
+        @testset "ZDD Operations" begin
+            native, cudd = DDManager(5), CuddManager(5)
+            sets = [[1, 2], [2, 3, 5], [4], Int[]]
+            fn, fc = zdd_from_sets(native, sets), zdd_from_sets(cudd, sets)
+            @test zdd_count(cudd, fc) == zdd_count(native, fn) == 4
+            @test count_nodes(cudd, fc) == count_nodes(native, fn)
+            @test zdd_count(cudd, zdd_subset1(cudd, fc, 2)) == 2
+            gc = zdd_union(cudd, fc, zdd_singleton(cudd, 3))
+            @test zdd_count(cudd, zdd_difference(cudd, gc, fc)) == 1
+            @test zdd_intersection(cudd, gc, fc) == fc
+            @test zdd_count(cudd, zdd_base(cudd)) == 1
+            @test zdd_count(cudd, zdd_empty(cudd)) == 0
+            close(cudd)
+        end
+
+        @testset "References, Collection and Reordering" begin
+            mgr = CuddManager(8)
+            x = [ith_var(mgr, i) for i in 1:8]
+            # x1 x5 + x2 x6 + x3 x7 + x4 x8 is large under this order
+            f = mgr.zero
+            for i in 1:4
+                f = bdd_or(mgr, f, bdd_and(mgr, x[i], x[i + 4]))
+            end
+            AlgebraicDecisionDiagrams.ref!(mgr, f)
+            minterms = count_minterms(mgr, f, 8)
+            before = count_nodes(mgr, f)
+            reduce_heap!(mgr, :sift)
+            @test count_nodes(mgr, f) < before
+            @test count_minterms(mgr, f, 8) == minterms
+            garbage_collect!(mgr)
+            @test gc_stats(mgr).runs >= 1
+            @test count_minterms(mgr, f, 8) == minterms
+            AlgebraicDecisionDiagrams.deref!(mgr, f)
+            @test memory_in_use(mgr) > 0
+            @test_throws ArgumentError reduce_heap!(mgr, :bogus)
+            close(mgr)
+            close(mgr)  # Closing twice is harmless
+            @test occursin("closed", sprint(show, mgr))
+        end
+
+        @testset "Temporaries Under Automatic Reordering" begin
+            native, cudd = DDManager(8), CuddManager(8)
+            function operands(mgr)
+                x = [ith_var(mgr, i) for i in 1:8]
+                f = foldl((a, i) -> bdd_or(mgr, a, bdd_and(mgr, x[i], x[i + 4])), 1:4; init = mgr.zero)
+                g = foldl((a, i) -> bdd_xor(mgr, a, x[i]), 1:8; init = mgr.zero)
+                a = add_plus(mgr, add_ith_var(mgr, 1),
+                             add_times(mgr, add_ith_var(mgr, 5), add_const(mgr, 3.0)))
+                return f, g, a
+            end
+            fn, gn, an = operands(native)
+            fc, gc, ac = operands(cudd)
+            bn, bc = add_ith_var(native, 2), add_ith_var(cudd, 2)
+            foreach(h -> AlgebraicDecisionDiagrams.ref!(cudd, h), (fc, gc, ac, bc))
+
+            # The next node reorders, and so collects garbage, inside the call:
+            # the cubes, constants and z variables the wrappers make must survive it
+            function reordering(op)
+                enable_reordering!(cudd; threshold = 1)
+                try
+                    return op()
+                finally
+                    disable_reordering!(cudd)
+                end
+            end
+            minterms(mgr, h) = count_minterms(mgr, h, 8)
+            @test minterms(cudd, reordering(() -> bdd_exists(cudd, fc, [1, 5]))) ==
+                  minterms(native, bdd_exists(native, fn, [1, 5]))
+            @test minterms(cudd, reordering(() -> bdd_forall(cudd, gc, [2]))) ==
+                  minterms(native, bdd_forall(native, gn, [2]))
+            @test minterms(cudd, reordering(() -> bdd_and_exists(cudd, fc, gc, [3, 7]))) ==
+                  minterms(native, bdd_and_exists(native, fn, gn, [3, 7]))
+
+            assignments = [Dict(v => isodd(bits >> (v - 1)) for v in 1:8) for bits in 0:255]
+            same(hn, hc) = all(d -> add_eval(native, hn, d) == add_eval(cudd, hc, d), assignments)
+            @test same(add_scalar_multiply(native, an, 2.0),
+                       reordering(() -> add_scalar_multiply(cudd, ac, 2.0)))
+            @test same(add_exist_abstract(native, an, [1]),
+                       reordering(() -> add_exist_abstract(cudd, ac, [1])))
+            @test same(add_univ_abstract(native, an, [5]),
+                       reordering(() -> add_univ_abstract(cudd, ac, [5])))
+            @test same(add_matrix_multiply(native, an, bn, [1, 5]),
+                       reordering(() -> add_matrix_multiply(cudd, ac, bc, [1, 5])))
+            close(cudd)
+        end
+    end
+end
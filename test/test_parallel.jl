@@ -0,0 +1,126 @@
+@testset "Parallel Operations" begin
+    @testset "Parallel BDD Apply" begin
+        n = 12
+        mgr = DDManager(n; threaded = true)
+        x = [ith_var(mgr, i) for i in 1:n]
+        f = mgr.zero
+        g = mgr.one
+        for i in 1:2:n-1
+            f = bdd_or(mgr, f, bdd_and(mgr, x[i], x[i + 1]))
+            g = bdd_and(mgr, g, bdd_xor(mgr, x[i], x[n - i + 1]))
+        end
+
+        # Canonical results: the parallel and sequential paths agree on ids
+        p_and = parallel_and(mgr, f, g)
+        p_or = parallel_or(mgr, f, g; depth = 4)
+        p_xor = parallel_xor(mgr, f, g)
+        p_ite = parallel_ite(mgr, x[3], f, g)
+
+        # Swapped or complemented operands hit the entries of the first call
+        and_hits() = only(s.hits for s in cache_stats(mgr) if s.op == "AND")
+        ite_hits() = only(s.hits for s in cache_stats(mgr) if s.op == "ITE")
+        hits = and_hits()
+        @test parallel_and(mgr, g, f) == p_and
+        @test and_hits() > hits
+        hits = ite_hits()
+        @test parallel_ite(mgr, bdd_not(mgr, x[3]), g, f) == p_ite
+        @test ite_hits() > hits
+        AlgebraicDecisionDiagrams.clear_cache!(mgr)
+        @test p_and == bdd_and(mgr, f, g)
+        @test p_or == bdd_or(mgr, f, g)
+        @test p_xor == bdd_xor(mgr, f, g)
+        @test p_ite == bdd_ite(mgr, x[3], f, g)
+        @test !mgr.cache.frozen
+
+        # Concurrent probes are all counted
+        reset_cache_stats!(mgr)
+        probe() = for _ in 1:10_000
+            AlgebraicDecisionDiagrams.cache_lookup(mgr, AlgebraicDecisionDiagrams.OP_XOR, f, g, UInt64(0))
+        end
+        foreach(wait, [Threads.@spawn(probe()) for _ in 1:4])
+        @test only(s.lookups for s in cache_stats(mgr) if s.op == "XOR") == 40_000
+
+        @test_throws ArgumentError parallel_and(DDManager(2), mgr.one, mgr.one)
+    end
+
+    @testset "Parallel ADD Apply" begin
+        mgr = DDManager(6; threaded = true)
+        f = add_const(mgr, 0.0)
+        g = add_const(mgr, 1.0)
+        for i in 1:6
+            f = add_plus(mgr, f, add_scalar_multiply(mgr, add_ith_var(mgr, i), Float64(i)))
+            g = add_times(mgr, g, add_plus(mgr, add_ith_var(mgr, i), add_const(mgr, 1.0)))
+        end
+        p = parallel_add_apply(mgr, max, f, g; depth = 3)
+        AlgebraicDecisionDiagrams.clear_cache!(mgr)
+        @test p == add_max(mgr, f, g)
+    end
+
+    @testset "Capacity Retry" begin
+        mgr = DDManager(2; threaded = true)
+        attempts = Ref(0)
+        result = AlgebraicDecisionDiagrams.run_parallel(mgr) do
+            attempts[] += 1
+            attempts[] == 1 && throw(AlgebraicDecisionDiagrams.NodeCapacityExceeded())
+            42
+        end
+        @test result == 42
+        @test attempts[] == 2
+        @test mgr.node_capacity == typemax(Int)
+    end
+
+    @testset "Transfer and Sharded Reduce" begin
+        src = DDManager(6)
+        x = [ith_var(src, i) for i in 1:6]
+        f = bdd_or(src, bdd_and(src, x[1], x[4]), bdd_xor(src, x[2], bdd_not(src, x[6])))
+
+        dst = DDManager(6)
+        g = transfer(src, dst, f)
+        @test count_nodes(dst, g) == count_nodes(src, f)
+        @test count_minterms(dst, g, 6) == count_minterms(src, f, 6)
+        @test transfer(src, dst, f) == g
+        @test transfer(src, src, f) == f
+        @test transfer(src, dst, [src.one, src.zero]) == [dst.one, dst.zero]
+
+        # A different order rebuilds the nodes that land above their children
+        other = AlgebraicDecisionDiagrams.set_initial_order!(DDManager(6), collect(6:-1:1))
+        h = transfer(src, other, f)
+        @test count_minterms(other, h, 6) == count_minterms(src, f, 6)
+        @test transfer(other, src, h) == f
+        @test_throws ArgumentError transfer(src, DDManager(3), f)
+
+        a = add_plus(src, add_scalar_multiply(src, add_ith_var(src, 1), 2.0), add_ith_var(src, 5))
+        b = transfer(src, other, a)
+        for bits in 0:3
+            assignment = Dict(1 => isodd(bits), 5 => bits >= 2)
+            @test add_eval(other, b, assignment) == add_eval(src, a, assignment)
+        end
+
+        zsrc = DDManager(5)
+        z = zdd_from_sets(zsrc, [[1, 2], [2, 3, 5], [4], Int[]])
+        zdst = DDManager(5)
+        @test zdd_count(zdst, transfer(zsrc, zdst, z)) == 4
+
+        mgr = DDManager(8)
+        y = [ith_var(mgr, i) for i in 1:8]
+        clauses = [bdd_or(mgr, y[i], bdd_not(mgr, y[i % 8 + 1])) for i in 1:8]
+        terms = [bdd_and(mgr, y[i], y[(i + 2) % 8 + 1]) for i in 1:8]
+        @test parallel_reduce(bdd_and, mgr, clauses; ntasks = 3) == foldl((p, q) -> bdd_and(mgr, p, q), clauses)
+        @test parallel_reduce(bdd_or, mgr, terms) == foldl((p, q) -> bdd_or(mgr, p, q), terms)
+        @test parallel_reduce(bdd_or, mgr, terms[1:1]; ntasks = 4) == terms[1]
+        # Associative but not commutative: the operands keep their order
+        @test parallel_reduce((m, f, g) -> f, mgr, terms; ntasks = 3) == terms[1]
+        @test parallel_reduce((m, f, g) -> g, mgr, terms; ntasks = 3) == terms[end]
+        @test_throws ArgumentError parallel_reduce(bdd_and, mgr, NodeId[])
+
+        # The shards take the tolerance, cache shape and limit of the source
+        amgr = DDManager(4; epsilon = 0.01, cache_ways = 2, max_nodes = 10_000)
+        parts = [add_scalar_multiply(amgr, add_ith_var(amgr, i), 2.0^i) for i in 1:4]
+        serial = foldl((p, q) -> add_plus(amgr, p, q), parts)
+        @test parallel_reduce(add_plus, amgr, parts; ntasks = 2) == serial
+        shard = AlgebraicDecisionDiagrams.shard_manager(amgr)
+        @test shard.epsilon == amgr.epsilon
+        @test shard.cache.ways == 2
+        @test shard.max_nodes == amgr.max_nodes
+    end
+end
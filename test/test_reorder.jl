@@ -0,0 +1,91 @@
+@testset "Variable Reordering" begin
+    # Evaluate a BDD under an assignment, independent of the variable order
+    function bdd_eval(mgr, f, a)
+        while !AlgebraicDecisionDiagrams.is_terminal(mgr, f)
+            index = AlgebraicDecisionDiagrams.get_node(mgr, f).index
+            f = a[index] ? AlgebraicDecisionDiagrams.then_child(mgr, f) :
+                           AlgebraicDecisionDiagrams.else_child(mgr, f)
+        end
+        return f == mgr.one
+    end
+
+    # (x1 ∧ x7) ∨ (x2 ∧ x8) ∨ ... is exponential in the identity order
+    function build_pairs(mgr, n)
+        f = mgr.zero
+        for i in 1:n÷2
+            f = bdd_or(mgr, f, bdd_and(mgr, ith_var(mgr, i), ith_var(mgr, i + n ÷ 2)))
+        end
+        return f
+    end
+
+    @testset "Sifting" begin
+        n = 12
+        mgr = DDManager(n)
+        f = build_pairs(mgr, n)
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        before = count_nodes(mgr, f)
+
+        reduce_heap!(mgr)
+        @test count_nodes(mgr, f) < before
+        @test sort(mgr.perm) == 1:n
+        @test all(mgr.invperm[mgr.perm[i]] == i for i in 1:n)
+
+        # Same function, and the unique tables still hash-cons correctly
+        @test all(0:(1 << n) - 1) do bits
+            a = [isodd(bits >> (i - 1)) for i in 1:n]
+            bdd_eval(mgr, f, a) == any(a[i] && a[i + n ÷ 2] for i in 1:n÷2)
+        end
+        @test build_pairs(mgr, n) == f
+    end
+
+    @testset "Window Permutation" begin
+        for method in (:window2, :window3)
+            mgr = DDManager(8)
+            f = build_pairs(mgr, 8)
+            g = bdd_xor(mgr, ith_var(mgr, 1), ith_var(mgr, 8))
+            AlgebraicDecisionDiagrams.ref!(mgr, f)
+            AlgebraicDecisionDiagrams.ref!(mgr, g)
+            before = count_nodes(mgr, f)
+
+            reduce_heap!(mgr, method)
+            @test count_nodes(mgr, f) <= before
+            @test build_pairs(mgr, 8) == f
+            @test bdd_xor(mgr, ith_var(mgr, 1), ith_var(mgr, 8)) == g
+        end
+        @test_throws ArgumentError reduce_heap!(DDManager(2), :random)
+    end
+
+    @testset "ADD Reordering" begin
+        mgr = DDManager(6)
+        f = add_const(mgr, 0.0)
+        for i in 1:3
+            f = add_plus(mgr, f, add_times(mgr, add_ith_var(mgr, i), add_ith_var(mgr, i + 3)))
+        end
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        reduce_heap!(mgr)
+        @test all(0:63) do bits
+            a = Dict(i => isodd(bits >> (i - 1)) for i in 1:6)
+            add_eval(mgr, f, a) == sum(a[i] && a[i + 3] for i in 1:3)
+        end
+    end
+
+    @testset "Automatic Reordering" begin
+        mgr = DDManager(12)
+        enable_reordering!(mgr; threshold = 64)
+        f = build_pairs(mgr, 12)
+        @test mgr.reorder_pending
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        check_reorder(mgr)
+        @test !mgr.reorder_pending
+        @test mgr.reorder_threshold >= 2 * mgr.num_nodes
+        @test build_pairs(mgr, 12) == f
+
+        disable_reordering!(mgr)
+        @test !mgr.auto_reorder
+
+        # ZDD nodes use a different reduction rule and are not reordered
+        zmgr = DDManager(3)
+        zdd_singleton(zmgr, 1)
+        @test_throws ArgumentError reduce_heap!(zmgr)
+    end
+end
@@ -0,0 +1,147 @@
+@testset "Serialization" begin
+    function build_pairs(mgr, n)
+        f = mgr.zero
+        for i in 1:n÷2
+            f = bdd_or(mgr, f, bdd_and(mgr, ith_var(mgr, i), ith_var(mgr, i + n ÷ 2)))
+        end
+        return f
+    end
+
+    @testset "BDD Round Trip" begin
+        mgr = DDManager(6)
+        x = [ith_var(mgr, i) for i in 1:6]
+        f = bdd_xor(mgr, bdd_or(mgr, x[1], bdd_not(mgr, x[3])), bdd_and(mgr, x[2], x[6]))
+
+        path, io = mktemp()
+        close(io)
+        save_dd(path, mgr, f)
+
+        # Loading into the same manager finds the existing nodes
+        @test load_dd(mgr, path) == f
+        @test load_dd(mgr, path; mmap = false) == f
+
+        # Complemented roots, through an IO
+        buf = IOBuffer()
+        save_dd(buf, mgr, bdd_not(mgr, f))
+        seekstart(buf)
+        @test load_dd(mgr, buf) == bdd_not(mgr, f)
+
+        # A fresh manager rebuilds the same function
+        mgr2, g = load_dd(path)
+        @test mgr2.num_vars == 6
+        @test count_nodes(mgr2, g) == count_nodes(mgr, f)
+        y = [ith_var(mgr2, i) for i in 1:6]
+        @test g == bdd_xor(mgr2, bdd_or(mgr2, y[1], bdd_not(mgr2, y[3])), bdd_and(mgr2, y[2], y[6]))
+
+        # Terminals
+        buf = IOBuffer()
+        save_dd(buf, mgr, mgr.zero)
+        @test load_dd(mgr, take!(buf)) == mgr.zero
+        rm(path)
+    end
+
+    @testset "ADD Round Trip" begin
+        mgr = DDManager(3)
+        x = [add_ith_var(mgr, i) for i in 1:3]
+        f = add_plus(mgr, add_scalar_multiply(mgr, x[1], 2.5), add_times(mgr, x[2], x[3]))
+
+        buf = IOBuffer()
+        save_dd(buf, mgr, f)
+        bytes = take!(buf)
+        @test load_dd(mgr, bytes) == f
+
+        mgr2, g = load_dd(bytes)
+        X = BitMatrix([isodd(r >> (i - 1)) for r in 0:7, i in 1:3])
+        @test add_eval_batch(mgr2, g, X) == add_eval_batch(mgr, f, X)
+    end
+
+    @testset "ZDD Round Trip" begin
+        mgr = DDManager(4)
+        sets = [[1, 2], [3], [2, 4], Int[]]
+        f = zdd_from_sets(mgr, sets)
+
+        buf = IOBuffer()
+        save_dd(buf, mgr, f)
+        mgr2, g = load_dd(take!(buf))
+        @test mgr2.has_zdd
+        @test sort(sort.(zdd_to_sets(mgr2, g))) == sort(sort.(sets))
+    end
+
+    @testset "Variable Order" begin
+        n = 8
+        mgr = DDManager(n)
+        f = build_pairs(mgr, n)
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        reduce_heap!(mgr)
+
+        buf = IOBuffer()
+        save_dd(buf, mgr, f)
+        bytes = take!(buf)
+
+        # The order travels with the file
+        mgr2, g = load_dd(bytes)
+        @test mgr2.invperm == mgr.invperm
+        @test mgr2.perm == mgr.perm
+        @test count_nodes(mgr2, g) == count_nodes(mgr, f)
+        @test build_pairs(mgr2, n) == g
+
+        # A manager with a conflicting order is refused
+        mgr3 = AlgebraicDecisionDiagrams.set_initial_order!(DDManager(2), [2, 1])
+        h = bdd_and(mgr3, ith_var(mgr3, 1), ith_var(mgr3, 2))
+        buf = IOBuffer()
+        save_dd(buf, mgr3, h)
+        @test_throws ArgumentError load_dd(DDManager(2), take!(buf))
+    end
+
+    @testset "Malformed Data" begin
+        mgr = DDManager(2)
+        @test_throws ArgumentError load_dd(mgr, UInt8[])
+        @test_throws ArgumentError load_dd(mgr, Vector{UInt8}("not a dd"))
+
+        buf = IOBuffer()
+        save_dd(buf, mgr, bdd_and(mgr, ith_var(mgr, 1), ith_var(mgr, 2)))
+        bytes = take!(buf)
+        @test_throws ArgumentError load_dd(mgr, bytes[1:end-2])
+        @test_throws ArgumentError load_dd(DDManager(1), bytes)
+    end
+
+    @testset "Shared Roots" begin
+        n = 8
+        mgr = DDManager(n)
+        x = [ith_var(mgr, i) for i in 1:n]
+        shared = bdd_and(mgr, bdd_or(mgr, x[5], x[6]), bdd_xor(mgr, x[7], x[8]))
+        roots = [bdd_and(mgr, x[1], shared), bdd_or(mgr, x[2], shared),
+                 bdd_not(mgr, shared), shared, mgr.one]
+
+        # Shared subgraphs are counted once
+        total = count_nodes(mgr, roots)
+        @test total == count_nodes(mgr, shared) + 2
+        @test total < sum(r -> count_nodes(mgr, r), roots)
+        @test count_nodes(mgr, NodeId[]) == 0
+
+        buf = IOBuffer()
+        save_dd(buf, mgr, roots)
+        bytes = take!(buf)
+        @test load_dds(mgr, bytes) == roots
+
+        mgr2, roots2 = load_dds(bytes)
+        @test count_nodes(mgr2, roots2) == total
+
+        # One dump is smaller than separate ones
+        separate = sum(roots) do r
+            b = IOBuffer()
+            save_dd(b, mgr, r)
+            length(take!(b))
+        end
+        @test length(bytes) < separate
+
+        # A single-root load refuses files with several roots
+        @test_throws ArgumentError load_dd(mgr, bytes)
+
+        path, io = mktemp()
+        close(io)
+        save_dd(path, mgr, roots)
+        @test load_dds(mgr, path) == roots
+        rm(path)
+    end
+end
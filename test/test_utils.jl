@@ -59,6 +59,39 @@
         # x1 AND x2 (quarter of assignments)
         f = bdd_and(mgr, x1, x2)
         @test count_minterms(mgr, f, 3) == 2.0
+
+        # Skipped levels and complement edges
+        x3 = ith_var(mgr, 3)
+        @test count_minterms(mgr, bdd_and(mgr, x1, x3), 3) == 2
+        @test count_minterms(mgr, bdd_not(mgr, f), 3) == 6
+        @test count_minterms(mgr, bdd_xor(mgr, x1, bdd_not(mgr, x3)), 3) == 4
+        @test count_minterms(mgr, bdd_or(mgr, bdd_not(mgr, x2), x3), 3) == 6
+        @test count_minterms(Float64, mgr, bdd_not(mgr, f), 3) === 6.0
+        @test log_count_minterms(mgr, bdd_not(mgr, f), 3) ≈ log2(6)
+        @test log_count_minterms(mgr, mgr.zero, 3) == -Inf
+        @test_throws ArgumentError count_minterms(mgr, x3, 2)
+    end
+
+    @testset "Large Minterm Counts" begin
+        mgr = DDManager(100)
+        f = bdd_and(mgr, ith_var(mgr, 1), bdd_not(mgr, ith_var(mgr, 100)))
+        @test count_minterms(mgr, f, 100) === UInt128(1) << 98
+        @test count_minterms(mgr, bdd_not(mgr, f), 100) == (UInt128(1) << 100) - (UInt128(1) << 98)
+
+        mgr = DDManager(200)
+        g = bdd_or(mgr, ith_var(mgr, 7), ith_var(mgr, 150))
+        @test count_minterms(mgr, g, 200) == big(2)^200 - big(2)^198
+        @test count_minterms(mgr, g, 200) isa BigInt
+        @test count_minterms(mgr, bdd_and(mgr, ith_var(mgr, 1), ith_var(mgr, 2)), 129) === UInt128(1) << 127
+
+        # Fixed-width counts throw instead of wrapping around
+        @test_throws OverflowError count_minterms(Int64, mgr, mgr.one, 70)
+        @test_throws OverflowError count_minterms(Int64, mgr, ith_var(mgr, 7), 70)
+        @test count_minterms(Int64, mgr, mgr.one, 62) === Int64(1) << 62
+        @test count_minterms(UInt64, mgr, bdd_not(mgr, ith_var(mgr, 1)), 64) === UInt64(1) << 63
+        @test count_minterms(Float64, mgr, g, 200) ≈ 0.75 * 2.0^200
+        @test log_count_minterms(mgr, g, 200) ≈ 200 + log2(0.75)
+        @test log_count_minterms(mgr, mgr.one, 200) == 200.0
     end
 
     @testset "Print DD" begin
@@ -168,4 +201,376 @@
         f3 = bdd_and(mgr, x1, x2)
         @test f1 == f3
     end
+
+    @testset "Node Store" begin
+        mgr = DDManager(3)
+        x1 = ith_var(mgr, 1)
+        x2 = ith_var(mgr, 2)
+        f = bdd_and(mgr, x1, x2)
+
+        store = mgr.nodes
+        @test length(store) == mgr.num_nodes
+        @test isbitstype(AlgebraicDecisionDiagrams.DDNode)
+
+        # Snapshots agree with the columns
+        slot = AlgebraicDecisionDiagrams.node_slot(f)
+        node = AlgebraicDecisionDiagrams.get_node(mgr, f)
+        @test node.index == store.index[slot] == 1
+        @test node.then_child == store.then_child[slot]
+        @test node.else_child == store.else_child[slot]
+        @test store[slot] == node
+
+        # Terminal slot
+        @test AlgebraicDecisionDiagrams.is_terminal(mgr, mgr.one)
+        @test !AlgebraicDecisionDiagrams.is_terminal(mgr, f)
+        @test AlgebraicDecisionDiagrams.terminal_value(mgr, mgr.one) == 1.0
+        @test mgr.values[store.then_child[AlgebraicDecisionDiagrams.node_slot(mgr.one)]] == 1.0
+
+        # Freed slots are reused after GC
+        AlgebraicDecisionDiagrams.ref!(mgr, x1)
+        garbage_collect!(mgr)
+        n = length(store)
+        g = bdd_and(mgr, x1, ith_var(mgr, 3))
+        @test length(store) <= n + 2
+        @test AlgebraicDecisionDiagrams.then_child(mgr, x1) == mgr.one
+    end
+
+    @testset "Set-Associative Cache" begin
+        @test_throws ArgumentError DDManager(2; cache_ways = 3)
+        @test_throws ArgumentError DDManager(2; cache_size = 1000)
+
+        # Results agree between direct-mapped and 4-way caches, even when tiny
+        results = map((1, 4)) do ways
+            mgr = DDManager(12; cache_size = 64, cache_ways = ways)
+            f = mgr.zero
+            for i in 1:2:11
+                f = bdd_or(mgr, f, bdd_and(mgr, ith_var(mgr, i), ith_var(mgr, i + 1)))
+            end
+            (count_minterms(mgr, f, 12), count_nodes(mgr, f), cache_stats(mgr))
+        end
+        @test results[1][1] == results[2][1]
+        @test results[1][2] == results[2][2]
+
+        ops = Dict(s.op => s for s in results[2][3])
+        @test haskey(ops, "AND") && haskey(ops, "OR")
+        @test all(s -> s.hits + s.misses == s.lookups, results[2][3])
+
+        # Repeated lookups hit until the entry is evicted
+        mgr = DDManager(4; cache_ways = 2)
+        x1, x2 = ith_var(mgr, 1), ith_var(mgr, 2)
+        bdd_xor(mgr, x1, x2)
+        reset_cache_stats!(mgr)
+        bdd_xor(mgr, x1, x2)
+        xor_stats = only(filter(s -> s.op == "XOR", cache_stats(mgr)))
+        @test xor_stats.hits == 1
+        @test xor_stats.misses == 0
+    end
+
+    @testset "Cache Resizing" begin
+        build(mgr) = begin
+            f = mgr.zero
+            for i in 1:2:15
+                f = bdd_or(mgr, f, bdd_and(mgr, ith_var(mgr, i), ith_var(mgr, i + 1)))
+            end
+            g = bdd_xor(mgr, f, ith_var(mgr, 16))
+            (count_minterms(mgr, g, 16), count_nodes(mgr, g))
+        end
+
+        # A table pinned at its initial size never grows
+        fixed = DDManager(16; cache_size = 64, max_cache_size = 64)
+        expected = build(fixed)
+        @test length(fixed.cache.entries) == 64
+        @test fixed.cache.resizes == 0
+
+        # A growable table doubles within its limit and computes the same results
+        mgr = DDManager(16; cache_size = 64, max_cache_size = 4096, cache_ways = 2)
+        for _ in 1:8
+            AlgebraicDecisionDiagrams.clear_cache!(mgr)
+            @test build(mgr) == expected
+        end
+        n = length(mgr.cache.entries)
+        @test 64 <= n <= 4096
+        @test ispow2(n)
+        @test mgr.cache.nsets == n ÷ 2
+
+        # The limit can be raised, but never below the current size
+        set_max_cache_size!(mgr, 16)
+        @test mgr.cache.max_size == n
+        set_max_cache_size!(mgr, 1 << 16)
+        @test mgr.max_cache_size == 1 << 16
+    end
+
+    @testset "Cache Survives GC" begin
+        mgr = DDManager(4)
+        x1, x2, x3, x4 = (ith_var(mgr, i) for i in 1:4)
+        for x in (x1, x2)
+            AlgebraicDecisionDiagrams.ref!(mgr, x)
+        end
+        f = bdd_and(mgr, x1, x2)
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        bdd_xor(mgr, bdd_and(mgr, x3, x4), x3)  # Unreferenced garbage
+
+        cache_ops(mgr) = [e.op for e in mgr.cache.entries if e.op != 0 && e.epoch == mgr.cache.epoch]
+        @test AlgebraicDecisionDiagrams.OP_XOR in cache_ops(mgr)
+
+        garbage_collect!(mgr)
+
+        # Entries over freed nodes are dropped, the live result is still cached
+        @test !(AlgebraicDecisionDiagrams.OP_XOR in cache_ops(mgr))
+        reset_cache_stats!(mgr)
+        @test bdd_and(mgr, x1, x2) == f
+        and_stats = only(filter(s -> s.op == "AND", cache_stats(mgr)))
+        @test and_stats.hits == 1
+
+        # Clearing advances the epoch, after which every lookup misses
+        AlgebraicDecisionDiagrams.clear_cache!(mgr)
+        @test isempty(cache_ops(mgr))
+        reset_cache_stats!(mgr)
+        @test bdd_and(mgr, x1, x2) == f
+        and_stats = only(filter(s -> s.op == "AND", cache_stats(mgr)))
+        @test and_stats.hits == 0
+    end
+
+    @testset "Deep GC" begin
+        # A chain deeper than any sane recursion limit on the mark phase
+        n = 5000
+        mgr = DDManager(n)
+        f = ith_var(mgr, n)
+        for i in n-1:-1:1
+            f = bdd_and(mgr, ith_var(mgr, i), f)
+        end
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        garbage_collect!(mgr)
+        @test count_nodes(mgr, f) == n
+        @test mgr.num_dead == 0
+
+        # Dropping the root frees the chain; projections stay alive
+        AlgebraicDecisionDiagrams.deref!(mgr, f)
+        @test mgr.num_dead == 1
+        live_before = mgr.num_nodes
+        garbage_collect!(mgr)
+        @test mgr.num_nodes == live_before - (n - 1)
+        @test mgr.num_dead == 0
+        @test all(t -> t.dead == 0, mgr.unique_tables)
+        @test AlgebraicDecisionDiagrams.then_child(mgr, ith_var(mgr, 1)) == mgr.one
+    end
+
+    @testset "Node Limits" begin
+        # x1x9 + x2x10 + ... + x8x16 is exponential in the natural order
+        pair_sum(mgr) = foldl((a, i) -> bdd_or(mgr, a, bdd_and(mgr, ith_var(mgr, i), ith_var(mgr, i + 8))),
+                           1:8; init = mgr.zero)
+        ref_mgr = DDManager(16)
+        full = pair_sum(ref_mgr)
+
+        # A query that does not fit aborts with a typed error
+        mgr = DDManager(16)
+        set_node_limit!(mgr, mgr.num_nodes + 20)
+        @test_throws NodeLimitExceeded pair_sum(mgr)
+        @test mgr.num_nodes <= mgr.max_nodes
+        @test mgr.limit_depth == 0
+        @test sprint(showerror, NodeLimitExceeded(36)) ==
+            "NodeLimitExceeded: the operation needs more than 36 nodes"
+
+        # ... and leaves the manager usable once the limit is lifted
+        set_node_limit!(mgr)
+        f = pair_sum(mgr)
+        @test count_nodes(mgr, f) == count_nodes(ref_mgr, full)
+        @test count_minterms(mgr, f, 16) == count_minterms(ref_mgr, full, 16)
+
+        # A store full of garbage is collected, keeping referenced diagrams
+        mgr = DDManager(16)
+        kept = bdd_and(mgr, ith_var(mgr, 1), ith_var(mgr, 2))
+        AlgebraicDecisionDiagrams.ref!(mgr, kept)
+        pair_sum(mgr)
+        set_node_limit!(mgr, mgr.num_nodes)
+        parity = foldl((a, i) -> bdd_xor(mgr, a, ith_var(mgr, i)), 1:16; init = mgr.zero)
+        @test count_minterms(mgr, parity, 16) == 2^15
+        @test count_minterms(mgr, kept, 16) == 2^14
+        @test mgr.num_nodes <= mgr.max_nodes
+
+        # Protecting the operands through the collection leaves no dead count behind
+        mgr = DDManager(16)
+        g = bdd_and(mgr, ith_var(mgr, 3), ith_var(mgr, 5))
+        pair_sum(mgr)
+        set_node_limit!(mgr, mgr.num_nodes)
+        h = bdd_or(mgr, g, ith_var(mgr, 7))
+        @test count_minterms(mgr, h, 16) == 5 * 2^13
+        @test mgr.num_dead == 0
+        @test all(t -> t.dead == 0, mgr.unique_tables)
+
+        # With reordering enabled, sifting makes the exponential query fit
+        mgr = DDManager(16)
+        enable_reordering!(mgr)
+        set_node_limit!(mgr, 200)
+        f = pair_sum(mgr)
+        @test count_minterms(mgr, f, 16) == count_minterms(ref_mgr, full, 16)
+        @test mgr.num_nodes <= 200
+
+        # Quantification runs as one limited operation
+        mgr = DDManager(16)
+        pair_sum(mgr)
+        set_node_limit!(mgr, mgr.num_nodes)
+        g = bdd_exists(mgr, bdd_and(mgr, ith_var(mgr, 1), ith_var(mgr, 9)), [1])
+        @test g == ith_var(mgr, 9)
+
+        # Memory limits are node limits at a fixed size per node
+        mgr = DDManager(4; max_memory = AlgebraicDecisionDiagrams.NODE_BYTES * 100)
+        @test mgr.max_nodes == 100
+        set_memory_limit!(mgr, 0)
+        @test mgr.max_nodes == typemax(Int)
+        @test DDManager(4; max_nodes = 50).max_nodes == 50
+        @test_throws ArgumentError set_node_limit!(mgr, 0)
+        @test_throws ArgumentError set_memory_limit!(mgr, -1)
+    end
+
+    @testset "Runtime Statistics" begin
+        # The default build compiles the counters in
+        @test AlgebraicDecisionDiagrams.STATS_COMPILED
+        mgr = DDManager(8)
+        @test !mgr.collect_stats
+        bdd_and(mgr, ith_var(mgr, 1), ith_var(mgr, 2))
+        @test all(l -> l.lookups == 0, unique_stats(mgr))
+        @test gc_stats(mgr).runs == 0
+
+        enable_stats!(mgr)
+        @test AlgebraicDecisionDiagrams.collecting_stats(mgr)
+        f = foldl((a, i) -> bdd_xor(mgr, a, ith_var(mgr, i)), 1:8; init = mgr.zero)
+        levels = unique_stats(mgr)
+        @test length(levels) == 8
+        @test sum(l -> l.lookups, levels) > 0
+        @test all(l -> l.lookups == 0 || l.avg_probe >= 0.0, levels)
+        @test gc_stats(mgr).peak_nodes == mgr.num_nodes
+
+        # Collections are counted with what they reclaimed
+        live = mgr.num_nodes
+        garbage_collect!(mgr)
+        gc = gc_stats(mgr)
+        @test gc.runs == 1
+        @test gc.reclaimed == live - mgr.num_nodes
+        @test gc.time >= 0.0
+        @test gc.peak_nodes == live
+
+        # Resizes of a level's table are recorded
+        mgr2 = DDManager(12; stats = true)
+        for k in 0:(1 << 11) - 1
+            bdd_from_cubes(mgr2, [[(k >> (j - 1)) & 1 for j in 1:11]])
+        end
+        @test sum(l -> l.resizes, unique_stats(mgr2)) > 0
+
+        report = sprint(print_stats, mgr)
+        @test occursin("Unique tables:", report)
+        @test occursin("Garbage collections: 1", report)
+        @test occursin("XOR", report)
+        @test memory_in_use(mgr) > 0
+        # Each unique-table bucket is counted once, next to the store's columns
+        buckets = sum(t -> length(t.slots), mgr.unique_tables) + length(mgr.const_table.slots)
+        @test memory_in_use(mgr) == 24 * length(mgr.nodes) + 8 * length(mgr.values) + 8 * buckets +
+                                    sizeof(AlgebraicDecisionDiagrams.CacheEntry) * length(mgr.cache.entries)
+
+        disable_stats!(mgr)
+        lookups = sum(l -> l.lookups, unique_stats(mgr))
+        bdd_or(mgr, f, ith_var(mgr, 3))
+        @test sum(l -> l.lookups, unique_stats(mgr)) == lookups
+
+        reset_stats!(mgr)
+        @test all(l -> l.lookups == 0 && l.resizes == 0, unique_stats(mgr))
+        @test gc_stats(mgr).runs == 0
+        @test gc_stats(mgr).peak_nodes == mgr.num_nodes
+        @test isempty(cache_stats(mgr))
+    end
+
+    @testset "Open-Addressing Unique Table" begin
+        # An 8-bucket table homes an entry at the top 3 bits of its fingerprint
+        table = AlgebraicDecisionDiagrams.UniqueTable(8)
+        fp(home, k) = UInt32(home - 1) << 29 | UInt32(2k + 1)
+        entries = [AlgebraicDecisionDiagrams.table_entry(fp(7, k), 10 + k) for k in 1:3]
+        push!(entries, AlgebraicDecisionDiagrams.table_entry(fp(8, 0), 20))
+        foreach(e -> AlgebraicDecisionDiagrams.insert_entry!(table, e), entries)
+
+        # The run starting at bucket 7 wraps around
+        @test table.slots[[7, 8, 1, 2]] == entries
+        @test table.keys == 4
+
+        # Removal shifts the rest of the run back, leaving no tombstone
+        AlgebraicDecisionDiagrams.remove_entry!(table, fp(7, 1), 11)
+        @test table.slots[[7, 8, 1]] == entries[2:4]
+        @test table.slots[2] == 0
+        @test table.keys == 3
+
+        # Rehashing keeps the selected entries without touching any node
+        AlgebraicDecisionDiagrams.rehash_table!(idx -> idx != 12, table, 16)
+        @test length(table.slots) == 16
+        @test table.keys == 2
+        @test sort(filter(!iszero, table.slots)) == sort(entries[3:4])
+
+        # Tables stay consistent through growth, collection and reordering
+        mgr = DDManager(12)
+        f = bdd_from_cubes(mgr, [[(k >> (j - 1)) & 1 for j in 1:12] for k in 0:3:4095])
+        AlgebraicDecisionDiagrams.ref!(mgr, f)
+        @test count_minterms(mgr, f, 12) == 1366
+        garbage_collect!(mgr)
+        reduce_heap!(mgr)
+        @test count_minterms(mgr, f, 12) == 1366
+        for table in mgr.unique_tables
+            @test count(!iszero, table.slots) == table.keys
+            @test 4 * table.keys <= 3 * length(table.slots)
+        end
+        @test sum(t -> t.keys, mgr.unique_tables) == mgr.num_nodes - 2
+    end
+
+    @testset "Handles" begin
+        mgr = DDManager(12)
+        x = [DDHandle(mgr, ith_var(mgr, i)) for i in 1:12]
+        f = bdd_and(x[1], x[2])
+        @test f isa DDHandle
+        @test f.id == bdd_and(mgr, x[1].id, x[2].id)
+        @test bdd_or(f, bdd_not(f)) == DDHandle(mgr, mgr.one)
+        @test count_minterms(f, 12) == 2.0^10
+        @test_throws ArgumentError bdd_and(f, DDHandle(DDManager(12), mgr.one))
+
+        release!(f)
+        release!(f)  # Releasing twice is harmless
+        @test_throws ArgumentError bdd_not(f)
+        @test occursin("released", sprint(show, f))
+
+        # Sustained load: every round replaces the accumulator, so the old
+        # ones are dropped to their finalizers and collected at safe points.
+        # A raw replay on a manager that never collects checks the result.
+        function churn(and, xor, lits)
+            state = UInt32(7)
+            acc = nothing
+            for round in 1:1000
+                pick = map(1:2) do _
+                    state = state * UInt32(1103515245) + UInt32(12345)
+                    Int(state >> 16) % length(lits) + 1
+                end
+                term = and(lits[pick[1]], lits[pick[2]])
+                acc = round % 10 == 1 ? term : xor(acc, term)
+                round % 25 == 0 && GC.gc()
+            end
+            return acc
+        end
+        hmgr = DDManager(16; stats = true)
+        y = [DDHandle(hmgr, ith_var(hmgr, i)) for i in 1:16]
+        peak = Ref(0)
+        tracked_and(f, g) = (peak[] = max(peak[], hmgr.num_nodes); bdd_and(f, g))
+        acc = churn(tracked_and, bdd_xor, y)
+        GC.gc()
+        @test bdd_or(acc, acc) == acc
+        @test gc_stats(hmgr).runs >= 1
+        @test peak[] < 2^14
+        raw = DDManager(16)
+        replay = churn((f, g) -> bdd_and(raw, f, g), (f, g) -> bdd_xor(raw, f, g),
+                       [ith_var(raw, i) for i in 1:16])
+        @test count_nodes(acc) == count_nodes(raw, replay)
+        @test count_minterms(acc, 16) == count_minterms(raw, replay, 16)
+
+        # ADD and ZDD operations return handles too
+        a = add_plus(DDHandle(mgr, add_ith_var(mgr, 1)), DDHandle(mgr, add_const(mgr, 2.0)))
+        @test add_eval(a, Dict(1 => true)) == 3.0
+        @test add_apply(max, a, DDHandle(mgr, add_const(mgr, 2.5))) isa DDHandle
+        zmgr = DDManager(4)
+        z = DDHandle(zmgr, zdd_from_sets(zmgr, [[1, 2], [3]]))
+        @test zdd_count(zdd_union(z, DDHandle(zmgr, zdd_singleton(zmgr, 4)))) == 3
+    end
 end
@@ -118,6 +118,33 @@
         s2 = zdd_singleton(mgr, 2)
         u = zdd_union(mgr, s1, s2)
         @test zdd_count(mgr, u) == 2
+        @test zdd_count(Float64, mgr, u) === 2.0
+        @test zdd_log_count(mgr, u) == 1.0
+        @test zdd_log_count(mgr, zdd_empty(mgr)) == -Inf
+    end
+
+    @testset "ZDD Large Counts" begin
+        # The power set of n variables: 2^n sets on n nodes
+        function power_set(mgr, n)
+            f = zdd_base(mgr)
+            for v in n:-1:1
+                f = AlgebraicDecisionDiagrams.zdd_unique_lookup(mgr, v, f, f)
+            end
+            return f
+        end
+
+        mgr = DDManager(100)
+        f = power_set(mgr, 100)
+        @test zdd_count(mgr, f) === UInt128(1) << 100
+
+        # Past UInt128 the count is redone with BigInt
+        mgr = DDManager(130)
+        g = power_set(mgr, 130)
+        @test zdd_count(mgr, g) == big(2)^130
+        @test zdd_count(mgr, g) isa BigInt
+        @test zdd_count(Float64, mgr, g) == 2.0^130
+        @test zdd_log_count(mgr, g) ≈ 130.0
+        @test zdd_count(mgr, zdd_difference(mgr, g, zdd_base(mgr))) == big(2)^130 - 1
     end
 
     @testset "ZDD From/To Sets" begin
@@ -190,4 +217,76 @@
         nodes_u = count_nodes(mgr, u)
         @test nodes_u >= count_nodes(mgr, s1)
     end
+
+    @testset "ZDD Difference With Different Tops" begin
+        mgr = DDManager(3)
+        f = zdd_from_sets(mgr, [[1], [2], [1, 2], [3]])
+
+        # g's top variable is below f's
+        g = zdd_from_sets(mgr, [[2], [3]])
+        result = zdd_to_sets(mgr, zdd_difference(mgr, f, g))
+        @test sort(sort.(result)) == [[1], [1, 2]]
+
+        # g's top variable is above f's
+        h = zdd_from_sets(mgr, [[2], [3]])
+        k = zdd_from_sets(mgr, [[1], [2]])
+        result = zdd_to_sets(mgr, zdd_difference(mgr, h, k))
+        @test sort.(result) == [[3]]
+    end
+
+    @testset "ZDD Set Iterator" begin
+        mgr = DDManager(5)
+        sets = [[1, 3], [2], [1, 2, 5], Int[], [4, 5]]
+        f = zdd_from_sets(mgr, sets)
+
+        @test [copy(s) for s in zdd_sets(mgr, f)] == zdd_to_sets(mgr, f)
+        @test sort(sort.(zdd_to_sets(mgr, f))) == sort(sort.(sets))
+        @test length(collect(Iterators.take(zdd_sets(mgr, f), 2))) == 2
+        @test isempty(collect(zdd_sets(mgr, zdd_empty(mgr))))
+        @test [copy(s) for s in zdd_sets(mgr, zdd_base(mgr))] == [Int[]]
+        @test eltype(zdd_sets(mgr, f)) == Vector{Int}
+
+        # Streaming a family far too large to materialize
+        mgr = DDManager(64)
+        g = zdd_base(mgr)
+        for v in 64:-1:1
+            g = AlgebraicDecisionDiagrams.zdd_unique_lookup(mgr, v, g, g)
+        end
+        firsts = [copy(s) for s in Iterators.take(zdd_sets(mgr, g), 3)]
+        @test firsts == [Int[], [64], [63]]
+    end
+
+    @testset "ZDD Bulk Construction" begin
+        mgr = DDManager(6)
+        sets = [[3, 1], [2], [1, 2, 5], Int[], [5, 4], [2], [6, 1, 1], [1, 3]]
+
+        # Same ZDD as folding singletons chains with unions
+        folded = zdd_empty(mgr)
+        for set in sets
+            chain = zdd_base(mgr)
+            for var in sort(unique(set); rev = true)
+                chain = AlgebraicDecisionDiagrams.zdd_unique_lookup(mgr, var, chain, zdd_empty(mgr))
+            end
+            folded = zdd_union(mgr, folded, chain)
+        end
+        f = zdd_from_sets(mgr, sets)
+        @test f == folded
+        @test zdd_count(mgr, f) == 6
+        @test zdd_from_sets(mgr, Vector{Int}[]) == zdd_empty(mgr)
+        @test zdd_from_sets(mgr, [Int[], Int[]]) == zdd_base(mgr)
+        @test_throws ArgumentError zdd_from_sets(mgr, [[7]])
+
+        # Under a different variable order
+        mgr2 = AlgebraicDecisionDiagrams.set_initial_order!(DDManager(6), [4, 6, 1, 5, 2, 3])
+        g = zdd_from_sets(mgr2, sets)
+        @test sort(sort.(zdd_to_sets(mgr2, g))) == sort(sort.(zdd_to_sets(mgr, f)))
+        @test zdd_union(mgr2, g, zdd_from_sets(mgr2, sets[1:3])) == g
+
+        # Parallel partitioning on a threaded manager
+        mgr3 = DDManager(12; threaded = true)
+        many = [[v for v in 1:12 if isodd(k >> (v - 1))] for k in 0:4095 if k % 3 != 0]
+        h = zdd_from_sets(mgr3, many; parallel = true)
+        @test h == zdd_from_sets(mgr3, many)
+        @test zdd_count(mgr3, h) == length(many)
+    end
 end